@@ -0,0 +1,21 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch.hpp>
@@ -0,0 +1,123 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_atomic_intrusive_pointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class Node : public CsPointer::CsIntrusiveBase
+{
+ public:
+   Node(int value)
+      : m_value(value)
+   {
+   }
+
+   int m_value;
+};
+
+using ReclaimPtr = CsPointer::CsIntrusivePointer<Node, CsPointer::CsIntrusiveReclaimPolicy<>>;
+
+constexpr int ReaderCount = 3;
+constexpr int LoadCount   = 20000;
+constexpr int StoreCount  = 2000;
+
+template <typename Load, typename Store>
+long run_contention(Load load, Store store)
+{
+   std::vector<std::thread> threads;
+   std::atomic<long> total = 0;
+
+   for (int i = 0; i < ReaderCount; ++i) {
+      threads.emplace_back([&load, &total] () {
+         long sum = 0;
+
+         for (int j = 0; j < LoadCount; ++j) {
+            sum += load();
+         }
+
+         total += sum;
+      });
+   }
+
+   threads.emplace_back([&store] () {
+      for (int j = 0; j < StoreCount; ++j) {
+         store(j);
+      }
+   });
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   return total;
+}
+
+}
+
+TEST_CASE("CsAtomicIntrusivePointer contention", "[benchmark]")
+{
+   BENCHMARK("CsAtomicIntrusivePointer") {
+      CsPointer::CsAtomicIntrusivePointer<Node> slot(CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveReclaimPolicy<>>(0));
+
+      return run_contention(
+            [&slot] () { return slot.load()->m_value; },
+            [&slot] (int value) { slot.store(CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveReclaimPolicy<>>(value)); });
+   };
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+   BENCHMARK("std::atomic<std::shared_ptr>") {
+      std::atomic<std::shared_ptr<Node>> slot(std::make_shared<Node>(0));
+
+      return run_contention(
+            [&slot] () { return slot.load()->m_value; },
+            [&slot] (int value) { slot.store(std::make_shared<Node>(value)); });
+   };
+#endif
+
+   BENCHMARK("std::mutex and CsIntrusivePointer") {
+      std::mutex mutex;
+      CsPointer::CsIntrusivePointer<Node> slot = CsPointer::make_intrusive<Node>(0);
+
+      return run_contention(
+            [&slot, &mutex] () {
+               CsPointer::CsIntrusivePointer<Node> ptr;
+
+               {
+                  std::lock_guard<std::mutex> lock(mutex);
+                  ptr = slot;
+               }
+
+               return ptr->m_value;
+            },
+
+            [&slot, &mutex] (int value) {
+               CsPointer::CsIntrusivePointer<Node> ptr = CsPointer::make_intrusive<Node>(value);
+
+               std::lock_guard<std::mutex> lock(mutex);
+               slot.swap(ptr);
+            });
+   };
+}
@@ -0,0 +1,85 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+class VirtualNode : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 0;
+};
+
+class StaticNode : public CsPointer::CsIntrusiveBaseT<StaticNode>
+{
+ public:
+   int m_value = 0;
+};
+
+class CompactNode : public CsPointer::CsIntrusiveBaseT<CompactNode, std::uint32_t>
+{
+ public:
+   int m_value = 0;
+};
+
+constexpr int NodeCount = 10000;
+
+template <typename T>
+std::size_t create_destroy()
+{
+   std::vector<CsPointer::CsIntrusivePointer<T>> list;
+   list.reserve(NodeCount);
+
+   for (int i = 0; i < NodeCount; ++i) {
+      list.push_back(CsPointer::make_intrusive<T>());
+   }
+
+   return list.size();
+}
+
+}
+
+TEST_CASE("CsIntrusiveBase sizeof", "[benchmark]")
+{
+   WARN("sizeof(CsIntrusiveBase node) = " << sizeof(VirtualNode)
+         << ", sizeof(CsIntrusiveBaseT node) = " << sizeof(StaticNode)
+         << ", sizeof(CsIntrusiveBaseT 32-bit node) = " << sizeof(CompactNode));
+
+   REQUIRE(sizeof(StaticNode) < sizeof(VirtualNode));
+}
+
+TEST_CASE("CsIntrusiveBase destroy", "[benchmark]")
+{
+   BENCHMARK("virtual base") {
+      return create_destroy<VirtualNode>();
+   };
+
+   BENCHMARK("crtp base") {
+      return create_destroy<StaticNode>();
+   };
+
+   BENCHMARK("crtp base 32-bit count") {
+      return create_destroy<CompactNode>();
+   };
+}
@@ -0,0 +1,174 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+class Node : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 0;
+};
+
+constexpr int ListSize = 10000;
+
+// larger than the last level cache, the objects are visited in a random order
+constexpr int ColdListSize = 1 << 20;
+
+class ColdNode : public CsPointer::CsIntrusiveBase
+{
+ public:
+   char m_payload[64] = {};
+};
+
+std::vector<CsPointer::CsIntrusivePointer<Node>> build_list(int targetCount)
+{
+   std::vector<CsPointer::CsIntrusivePointer<Node>> targets;
+
+   for (int i = 0; i < targetCount; ++i) {
+      targets.push_back(CsPointer::make_intrusive<Node>());
+   }
+
+   std::vector<CsPointer::CsIntrusivePointer<Node>> retval;
+
+   for (int i = 0; i < ListSize; ++i) {
+      retval.push_back(targets[i % targetCount]);
+   }
+
+   return retval;
+}
+
+std::vector<CsPointer::CsIntrusivePointer<ColdNode>> build_cold_list()
+{
+   std::vector<CsPointer::CsIntrusivePointer<ColdNode>> retval;
+   retval.reserve(ColdListSize);
+
+   for (int i = 0; i < ColdListSize; ++i) {
+      retval.push_back(CsPointer::make_intrusive<ColdNode>());
+   }
+
+   std::shuffle(retval.begin(), retval.end(), std::mt19937(42));
+
+   return retval;
+}
+
+}
+
+TEST_CASE("CsIntrusiveBatch copy_fan_in", "[benchmark]")
+{
+   auto list = build_list(4);
+
+   BENCHMARK("vector copy") {
+      std::vector<CsPointer::CsIntrusivePointer<Node>> tmp = list;
+      return tmp.size();
+   };
+
+   BENCHMARK("copy_intrusive") {
+      std::vector<CsPointer::CsIntrusivePointer<Node>> tmp = CsPointer::copy_intrusive(list);
+      return tmp.size();
+   };
+
+   BENCHMARK("copy_intrusive and release_intrusive") {
+      std::vector<CsPointer::CsIntrusivePointer<Node>> tmp = CsPointer::copy_intrusive(list);
+      std::size_t retval = tmp.size();
+
+      CsPointer::release_intrusive(tmp);
+      return retval;
+   };
+}
+
+TEST_CASE("CsIntrusiveBatch copy_distinct", "[benchmark]")
+{
+   auto list = build_list(ListSize);
+
+   BENCHMARK("vector copy") {
+      std::vector<CsPointer::CsIntrusivePointer<Node>> tmp = list;
+      return tmp.size();
+   };
+
+   BENCHMARK("copy_intrusive") {
+      std::vector<CsPointer::CsIntrusivePointer<Node>> tmp = CsPointer::copy_intrusive(list);
+      return tmp.size();
+   };
+}
+
+TEST_CASE("CsIntrusiveBatch release_cold", "[benchmark]")
+{
+   // each object is still held by list, only the decrements are measured
+   auto list = build_cold_list();
+
+   BENCHMARK_ADVANCED("vector clear")(Catch::Benchmark::Chronometer meter) {
+      std::vector<std::vector<CsPointer::CsIntrusivePointer<ColdNode>>> tmp(meter.runs(), list);
+
+      meter.measure([&tmp] (int i) {
+         tmp[i].clear();
+      });
+   };
+
+   BENCHMARK_ADVANCED("release_intrusive")(Catch::Benchmark::Chronometer meter) {
+      std::vector<std::vector<CsPointer::CsIntrusivePointer<ColdNode>>> tmp(meter.runs(), list);
+
+      meter.measure([&tmp] (int i) {
+         CsPointer::release_intrusive(tmp[i]);
+      });
+   };
+
+   BENCHMARK_ADVANCED("release_intrusive_range")(Catch::Benchmark::Chronometer meter) {
+      std::vector<std::vector<CsPointer::CsIntrusivePointer<ColdNode>>> tmp(meter.runs(), list);
+
+      meter.measure([&tmp] (int i) {
+         CsPointer::release_intrusive_range(tmp[i].data(), tmp[i].data() + tmp[i].size());
+      });
+   };
+}
+
+TEST_CASE("CsIntrusiveBatch release_cold_owned", "[benchmark]")
+{
+   // every release deletes the object
+
+   BENCHMARK_ADVANCED("vector clear")(Catch::Benchmark::Chronometer meter) {
+      std::vector<std::vector<CsPointer::CsIntrusivePointer<ColdNode>>> tmp(meter.runs());
+
+      for (auto &item : tmp) {
+         item = build_cold_list();
+      }
+
+      meter.measure([&tmp] (int i) {
+         tmp[i].clear();
+      });
+   };
+
+   BENCHMARK_ADVANCED("release_intrusive_range")(Catch::Benchmark::Chronometer meter) {
+      std::vector<std::vector<CsPointer::CsIntrusivePointer<ColdNode>>> tmp(meter.runs());
+
+      for (auto &item : tmp) {
+         item = build_cold_list();
+      }
+
+      meter.measure([&tmp] (int i) {
+         CsPointer::release_intrusive_range(tmp[i].data(), tmp[i].data() + tmp[i].size());
+      });
+   };
+}
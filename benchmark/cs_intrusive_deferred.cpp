@@ -0,0 +1,111 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_deferred.h>
+#include <cs_nodemanager.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+template <typename Policy>
+class TreeNode : public CsPointer::CsNodeManager<TreeNode<Policy>, Policy>, public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 0;
+};
+
+constexpr int NodeCount   = 100000;
+constexpr int SampleCount = 50;
+
+template <typename Policy>
+CsPointer::CsIntrusivePointer<TreeNode<Policy>, Policy> build_tree()
+{
+   auto root = CsPointer::make_intrusive<TreeNode<Policy>, Policy>();
+
+   for (int i = 0; i < NodeCount / 100; ++i) {
+      auto branch = CsPointer::make_intrusive<TreeNode<Policy>, Policy>();
+
+      for (int j = 0; j < 99; ++j) {
+         branch->add_child(CsPointer::make_intrusive<TreeNode<Policy>, Policy>());
+      }
+
+      root->add_child(branch);
+   }
+
+   return root;
+}
+
+// time spent in the thread which releases the last reference
+template <typename Policy>
+std::vector<double> release_latency()
+{
+   std::vector<double> retval;
+
+   for (int i = 0; i < SampleCount; ++i) {
+      auto root = build_tree<Policy>();
+
+      auto start = std::chrono::steady_clock::now();
+      root.reset();
+      auto end   = std::chrono::steady_clock::now();
+
+      retval.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+   }
+
+   std::sort(retval.begin(), retval.end());
+
+   return retval;
+}
+
+std::string histogram(const std::string &name, const std::vector<double> &samples)
+{
+   auto percentile = [&samples] (double value) {
+      return samples[std::size_t(value * (samples.size() - 1))];
+   };
+
+   std::ostringstream stream;
+   stream << name << " release latency (us): p50 = " << percentile(0.5) << ", p90 = " << percentile(0.9)
+          << ", p99 = " << percentile(0.99) << ", max = " << samples.back();
+
+   return stream.str();
+}
+
+}
+
+TEST_CASE("CsIntrusiveDeferred release_latency", "[benchmark]")
+{
+   using DeferredPolicy = CsPointer::CsIntrusiveDeferredPolicy<>;
+
+   std::vector<double> inlineSamples = release_latency<CsPointer::CsIntrusiveDefaultPolicy>();
+
+   CsPointer::CsDeferredQueue::global().start();
+   std::vector<double> deferredSamples = release_latency<DeferredPolicy>();
+
+   CsPointer::CsDeferredQueue::global().stop();
+   CsPointer::CsDeferredQueue::global().drain();
+
+   WARN(histogram("inline", inlineSamples));
+   WARN(histogram("deferred", deferredSamples));
+
+   REQUIRE(deferredSamples.size() == inlineSamples.size());
+}
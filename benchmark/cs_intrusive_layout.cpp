@@ -0,0 +1,140 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_layout.h>
+#include <cs_intrusive_pointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <typename Base>
+class Node : public Base
+{
+ public:
+   using Base::Base;
+
+   int m_values[4] = {1, 2, 3, 4};
+};
+
+constexpr int ReadCount = 100000;
+
+// other threads copy the pointer continuously while the benchmark reads the payload
+template <typename T>
+class CopyLoad
+{
+ public:
+   explicit CopyLoad(const CsPointer::CsIntrusivePointer<T> &ptr)
+   {
+      unsigned int threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+      for (unsigned int i = 0; i < threadCount; ++i) {
+         m_threads.emplace_back([this, ptr] () {
+            while (! m_stop.load(std::memory_order_relaxed)) {
+               CsPointer::CsIntrusivePointer<T> tmp = ptr;
+            }
+         });
+      }
+   }
+
+   ~CopyLoad()
+   {
+      m_stop.store(true);
+
+      for (auto &item : m_threads) {
+         item.join();
+      }
+   }
+
+ private:
+   std::atomic<bool> m_stop = false;
+   std::vector<std::thread> m_threads;
+};
+
+template <typename T>
+int read_payload(const T *obj)
+{
+   int retval = 0;
+
+   for (int i = 0; i < ReadCount; ++i) {
+      const volatile int *values = obj->m_values;
+      retval += values[i & 3];
+   }
+
+   return retval;
+}
+
+}
+
+TEST_CASE("CsIntrusiveLayout read_under_copy", "[benchmark]")
+{
+   auto ptr1 = CsPointer::make_intrusive<Node<CsPointer::CsIntrusiveBase>>();
+   auto ptr2 = CsPointer::make_intrusive<Node<CsPointer::CsIntrusiveBase_Aligned>>();
+   auto ptr3 = CsPointer::make_intrusive<Node<CsPointer::CsIntrusiveBase_Header>>();
+
+   {
+      CopyLoad load(ptr1);
+
+      BENCHMARK("count next to payload") {
+         return read_payload(ptr1.get());
+      };
+   }
+
+   {
+      CopyLoad load(ptr2);
+
+      BENCHMARK("count on separate cache line") {
+         return read_payload(ptr2.get());
+      };
+   }
+
+   {
+      CopyLoad load(ptr3);
+
+      BENCHMARK("count in header") {
+         return read_payload(ptr3.get());
+      };
+   }
+}
+
+TEST_CASE("CsIntrusiveLayout copy", "[benchmark]")
+{
+   auto ptr1 = CsPointer::make_intrusive<Node<CsPointer::CsIntrusiveBase>>();
+   auto ptr2 = CsPointer::make_intrusive<Node<CsPointer::CsIntrusiveBase_Aligned>>();
+   auto ptr3 = CsPointer::make_intrusive<Node<CsPointer::CsIntrusiveBase_Header>>();
+
+   BENCHMARK("count next to payload") {
+      auto tmp = ptr1;
+      return tmp.get();
+   };
+
+   BENCHMARK("count on separate cache line") {
+      auto tmp = ptr2;
+      return tmp.get();
+   };
+
+   BENCHMARK("count in header") {
+      auto tmp = ptr3;
+      return tmp.get();
+   };
+}
@@ -0,0 +1,139 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_biased.h>
+#include <cs_intrusive_pointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+class Node : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 0;
+};
+
+class LocalNode : public CsPointer::CsIntrusiveBase_ST
+{
+ public:
+   int m_value = 0;
+};
+
+class BiasedNode : public CsPointer::CsIntrusiveBase_Biased
+{
+ public:
+   int m_value = 0;
+};
+
+constexpr int CopyCount   = 10000;
+constexpr int ThreadCount = 4;
+
+template <typename T, typename Policy>
+std::size_t copy_into_vector(const CsPointer::CsIntrusivePointer<T, Policy> &ptr)
+{
+   std::vector<CsPointer::CsIntrusivePointer<T, Policy>> list(CopyCount, ptr);
+   return list.size();
+}
+
+template <typename Policy>
+std::size_t copy_threaded(const CsPointer::CsIntrusivePointer<Node, Policy> &ptr)
+{
+   std::vector<std::thread> threads;
+
+   for (int i = 0; i < ThreadCount; ++i) {
+      threads.emplace_back([&ptr] () {
+         for (int j = 0; j < CopyCount; ++j) {
+            CsPointer::CsIntrusivePointer<Node, Policy> tmp = ptr;
+         }
+      });
+   }
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   return ptr.use_count();
+}
+
+}
+
+TEST_CASE("CsIntrusivePolicy copy", "[benchmark]")
+{
+   auto ptr1 = CsPointer::make_intrusive<Node>();
+   auto ptr2 = CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveAcqRelPolicy>();
+   auto ptr3 = CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveRelaxedPolicy>();
+   auto ptr4 = CsPointer::make_intrusive<LocalNode, CsPointer::CsIntrusiveSingleThreadPolicy>();
+   auto ptr5 = CsPointer::make_intrusive<BiasedNode, CsPointer::CsIntrusiveBiasedPolicy>();
+   auto ptr6 = CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveImmortalPolicy<>>();
+
+   CsPointer::freeze(ptr6);
+
+   BENCHMARK("default policy") {
+      return copy_into_vector(ptr1);
+   };
+
+   BENCHMARK("acq_rel policy") {
+      return copy_into_vector(ptr2);
+   };
+
+   BENCHMARK("relaxed policy") {
+      return copy_into_vector(ptr3);
+   };
+
+   BENCHMARK("single thread policy") {
+      return copy_into_vector(ptr4);
+   };
+
+   BENCHMARK("biased policy") {
+      return copy_into_vector(ptr5);
+   };
+
+   BENCHMARK("immortal policy, frozen") {
+      return copy_into_vector(ptr6);
+   };
+}
+
+TEST_CASE("CsIntrusivePolicy copy_threaded", "[benchmark]")
+{
+   auto ptr1 = CsPointer::make_intrusive<Node>();
+   auto ptr2 = CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveAcqRelPolicy>();
+   auto ptr3 = CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveRelaxedPolicy>();
+   auto ptr4 = CsPointer::make_intrusive<Node, CsPointer::CsIntrusiveImmortalPolicy<>>();
+
+   CsPointer::freeze(ptr4);
+
+   BENCHMARK("default policy") {
+      return copy_threaded(ptr1);
+   };
+
+   BENCHMARK("acq_rel policy") {
+      return copy_threaded(ptr2);
+   };
+
+   BENCHMARK("relaxed policy") {
+      return copy_threaded(ptr3);
+   };
+
+   BENCHMARK("immortal policy, frozen") {
+      return copy_threaded(ptr4);
+   };
+}
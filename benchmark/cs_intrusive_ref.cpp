@@ -0,0 +1,89 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+#include <cs_intrusive_ref.h>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+class Node : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 1;
+};
+
+constexpr int CallCount = 1000;
+
+int by_value(CsPointer::CsIntrusivePointer<Node> ptr)
+{
+   return ptr->m_value;
+}
+
+int by_reference(const CsPointer::CsIntrusivePointer<Node> &ptr)
+{
+   return ptr->m_value;
+}
+
+int by_borrowed(CsPointer::CsIntrusiveRef<Node> ptr)
+{
+   return ptr->m_value;
+}
+
+// called through pointers so the compiler can not inline the helpers
+int (*volatile s_byValue)(CsPointer::CsIntrusivePointer<Node>)            = by_value;
+int (*volatile s_byReference)(const CsPointer::CsIntrusivePointer<Node> &) = by_reference;
+int (*volatile s_byBorrowed)(CsPointer::CsIntrusiveRef<Node>)             = by_borrowed;
+
+}
+
+TEST_CASE("CsIntrusiveRef call", "[benchmark]")
+{
+   auto ptr = CsPointer::make_intrusive<Node>();
+
+   BENCHMARK("CsIntrusivePointer by value") {
+      int retval = 0;
+
+      for (int i = 0; i < CallCount; ++i) {
+         retval += s_byValue(ptr);
+      }
+
+      return retval;
+   };
+
+   BENCHMARK("CsIntrusivePointer by const reference") {
+      int retval = 0;
+
+      for (int i = 0; i < CallCount; ++i) {
+         retval += s_byReference(ptr);
+      }
+
+      return retval;
+   };
+
+   BENCHMARK("CsIntrusiveRef") {
+      int retval = 0;
+
+      for (int i = 0; i < CallCount; ++i) {
+         retval += s_byBorrowed(ptr);
+      }
+
+      return retval;
+   };
+}
@@ -0,0 +1,101 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+#include <cs_intrusive_sharded.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class Node : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 0;
+};
+
+class ShardedNode : public CsPointer::CsIntrusiveBase_Sharded
+{
+ public:
+   int m_value = 0;
+};
+
+constexpr int CopyCount = 100000;
+
+template <typename T, typename Policy>
+std::size_t copy_threaded(const CsPointer::CsIntrusivePointer<T, Policy> &ptr, unsigned int threadCount)
+{
+   std::vector<std::thread> threads;
+
+   for (unsigned int i = 0; i < threadCount; ++i) {
+      threads.emplace_back([&ptr] () {
+         for (int j = 0; j < CopyCount; ++j) {
+            CsPointer::CsIntrusivePointer<T, Policy> tmp = ptr;
+         }
+      });
+   }
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   return ptr.use_count();
+}
+
+std::vector<unsigned int> thread_counts()
+{
+   unsigned int maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+   std::vector<unsigned int> retval;
+
+   for (unsigned int count = 1; count < maxThreads; count *= 2) {
+      retval.push_back(count);
+   }
+
+   retval.push_back(maxThreads);
+
+   return retval;
+}
+
+}
+
+TEST_CASE("CsIntrusiveSharded scaling", "[benchmark]")
+{
+   auto ptr1 = CsPointer::make_intrusive<Node>();
+   auto ptr2 = CsPointer::make_intrusive<ShardedNode, CsPointer::CsIntrusiveShardedPolicy>();
+
+   CsPointer::CsIntrusiveShardedPolicy::enable_sharding(ptr2.get());
+
+   for (unsigned int threadCount : thread_counts()) {
+      std::string suffix = ", " + std::to_string(threadCount) + " threads";
+
+      BENCHMARK("default policy" + suffix) {
+         return copy_threaded(ptr1, threadCount);
+      };
+
+      BENCHMARK("sharded policy" + suffix) {
+         return copy_threaded(ptr2, threadCount);
+      };
+   }
+
+   CsPointer::CsIntrusiveShardedPolicy::collapse(ptr2.get());
+}
@@ -0,0 +1,102 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_teardown.h>
+#include <cs_nodemanager.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <sstream>
+
+namespace {
+
+template <typename Policy>
+class Link : public CsPointer::CsIntrusiveBase
+{
+ public:
+   CsPointer::CsIntrusivePointer<Link, Policy> m_next;
+};
+
+class Level : public CsPointer::CsNodeManager<Level>, public CsPointer::CsIntrusiveBase
+{
+};
+
+constexpr int LongLength  = 10000000;
+constexpr int ShortLength = 50000;
+
+template <typename Policy>
+double chain_teardown(int length)
+{
+   auto head  = CsPointer::make_intrusive<Link<Policy>, Policy>();
+   auto *tail = head.get();
+
+   for (int i = 1; i < length; ++i) {
+      tail->m_next = CsPointer::make_intrusive<Link<Policy>, Policy>();
+      tail = tail->m_next.get();
+   }
+
+   auto start = std::chrono::steady_clock::now();
+   head.reset();
+   auto end   = std::chrono::steady_clock::now();
+
+   return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+double tree_teardown(int depth)
+{
+   auto root = CsPointer::make_intrusive<Level>();
+   Level *parent = root.get();
+
+   for (int i = 0; i < depth; ++i) {
+      auto child = CsPointer::make_intrusive<Level>();
+      parent->add_child(child);
+
+      parent = child.get();
+   }
+
+   auto start = std::chrono::steady_clock::now();
+   root.reset();
+   auto end   = std::chrono::steady_clock::now();
+
+   return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::string report(const std::string &name, int length, double ms)
+{
+   std::ostringstream stream;
+   stream << name << ", " << length << " nodes: " << ms << " ms, " << (ms * 1e6 / length) << " ns per node";
+
+   return stream.str();
+}
+
+}
+
+TEST_CASE("CsIntrusiveTeardown chain", "[benchmark]")
+{
+   using IterativePolicy = CsPointer::CsIntrusiveIterativePolicy<>;
+
+   // recursive teardown of the long chain overflows the stack
+   WARN(report("recursive chain", ShortLength, chain_teardown<CsPointer::CsIntrusiveDefaultPolicy>(ShortLength)));
+   WARN(report("iterative chain", ShortLength, chain_teardown<IterativePolicy>(ShortLength)));
+
+   WARN(report("iterative chain", LongLength, chain_teardown<IterativePolicy>(LongLength)));
+   WARN(report("CsNodeManager tree", LongLength, tree_teardown(LongLength)));
+
+   REQUIRE(true);
+}
@@ -0,0 +1,141 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+#include <cs_shared_pointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+namespace {
+
+class Fruit : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 0;
+};
+
+class Apple : public Fruit
+{
+};
+
+// counts the reference count operations issued by the pointer
+class CountingPolicy
+{
+ public:
+   static inline std::size_t s_opCount = 0;
+
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      ++s_opCount;
+      CsPointer::CsIntrusiveDefaultPolicy::inc_ref_count(ptr);
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsPointer::CsIntrusiveAction action = CsPointer::CsIntrusiveAction::Normal) {
+      ++s_opCount;
+      return CsPointer::CsIntrusiveDefaultPolicy::dec_ref_count(ptr, action);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return CsPointer::CsIntrusiveDefaultPolicy::get_ref_count(ptr);
+   }
+};
+
+constexpr int CastCount = 1000;
+
+}
+
+TEST_CASE("CsPointerCast count", "[benchmark]")
+{
+   CsPointer::CsIntrusivePointer<Apple, CountingPolicy> ptr = CsPointer::make_intrusive<Apple, CountingPolicy>();
+
+   CountingPolicy::s_opCount = 0;
+
+   for (int i = 0; i < CastCount; ++i) {
+      CsPointer::CsIntrusivePointer<Apple, CountingPolicy> tmp = ptr;
+      CsPointer::CsIntrusivePointer<Fruit, CountingPolicy> result = CsPointer::static_pointer_cast<Fruit>(tmp);
+   }
+
+   std::size_t copyOps = CountingPolicy::s_opCount;
+   CountingPolicy::s_opCount = 0;
+
+   for (int i = 0; i < CastCount; ++i) {
+      CsPointer::CsIntrusivePointer<Apple, CountingPolicy> tmp = ptr;
+      CsPointer::CsIntrusivePointer<Fruit, CountingPolicy> result = CsPointer::static_pointer_cast<Fruit>(std::move(tmp));
+   }
+
+   std::size_t moveOps = CountingPolicy::s_opCount;
+
+   WARN("Operations per copy and cast, const& cast: " << copyOps / CastCount << "  rvalue cast: " << moveOps / CastCount);
+
+   REQUIRE(moveOps < copyOps);
+}
+
+TEST_CASE("CsPointerCast intrusive", "[benchmark]")
+{
+   CsPointer::CsIntrusivePointer<Apple> ptr = CsPointer::make_intrusive<Apple>();
+
+   BENCHMARK("static_pointer_cast const&") {
+      CsPointer::CsIntrusivePointer<Apple> tmp = ptr;
+      CsPointer::CsIntrusivePointer<Fruit> result = CsPointer::static_pointer_cast<Fruit>(tmp);
+      return result.get();
+   };
+
+   BENCHMARK("static_pointer_cast rvalue") {
+      CsPointer::CsIntrusivePointer<Apple> tmp = ptr;
+      CsPointer::CsIntrusivePointer<Fruit> result = CsPointer::static_pointer_cast<Fruit>(std::move(tmp));
+      return result.get();
+   };
+
+   BENCHMARK("dynamic_pointer_cast const&") {
+      CsPointer::CsIntrusivePointer<Fruit> tmp = ptr;
+      CsPointer::CsIntrusivePointer<Apple> result = CsPointer::dynamic_pointer_cast<Apple>(tmp);
+      return result.get();
+   };
+
+   BENCHMARK("dynamic_pointer_cast rvalue") {
+      CsPointer::CsIntrusivePointer<Fruit> tmp = ptr;
+      CsPointer::CsIntrusivePointer<Apple> result = CsPointer::dynamic_pointer_cast<Apple>(std::move(tmp));
+      return result.get();
+   };
+}
+
+TEST_CASE("CsPointerCast shared", "[benchmark]")
+{
+   CsPointer::CsSharedPointer<Apple> ptr = CsPointer::make_shared<Apple>();
+
+   BENCHMARK("copy to std::shared_ptr then cast") {
+      // previous implementation of the const& cast
+      CsPointer::CsSharedPointer<Fruit> result = std::static_pointer_cast<Fruit>(std::shared_ptr<Apple>(ptr));
+      return result.get();
+   };
+
+   BENCHMARK("static_pointer_cast const&") {
+      CsPointer::CsSharedPointer<Fruit> result = CsPointer::static_pointer_cast<Fruit>(ptr);
+      return result.get();
+   };
+
+   BENCHMARK("copy and static_pointer_cast rvalue") {
+      CsPointer::CsSharedPointer<Apple> tmp = ptr;
+      CsPointer::CsSharedPointer<Fruit> result = CsPointer::static_pointer_cast<Fruit>(std::move(tmp));
+      return result.get();
+   };
+}
@@ -0,0 +1,80 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+#include <cs_small_vector.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+class Node : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_value = 0;
+};
+
+constexpr int ListSize = 10000;
+
+}
+
+TEST_CASE("CsSmallVector grow", "[benchmark]")
+{
+   // empty pointers, the time is spent relocating elements when the storage grows
+   BENCHMARK("std::vector push_back") {
+      std::vector<CsPointer::CsIntrusivePointer<Node>> tmp;
+
+      for (int i = 0; i < ListSize; ++i) {
+         tmp.emplace_back();
+      }
+
+      return tmp.size();
+   };
+
+   BENCHMARK("CsSmallVector push_back") {
+      CsPointer::CsSmallVector<CsPointer::CsIntrusivePointer<Node>> tmp;
+
+      for (int i = 0; i < ListSize; ++i) {
+         tmp.emplace_back();
+      }
+
+      return tmp.size();
+   };
+}
+
+TEST_CASE("CsSmallVector move_element", "[benchmark]")
+{
+   std::vector<CsPointer::CsIntrusivePointer<Node>> list;
+
+   for (int i = 0; i < ListSize; ++i) {
+      list.push_back(CsPointer::make_intrusive<Node>());
+   }
+
+   BENCHMARK("std::rotate") {
+      std::rotate(list.begin(), list.begin() + 1, list.end());
+      return list.front().get();
+   };
+
+   BENCHMARK("cs_relocate_element") {
+      CsPointer::cs_relocate_element(list.data(), 0, list.size() - 1);
+      return list.front().get();
+   };
+}
@@ -0,0 +1,148 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_ATOMIC_INTRUSIVE_POINTER_H
+#define LIB_CS_ATOMIC_INTRUSIVE_POINTER_H
+
+#include <cs_intrusive_pointer.h>
+#include <cs_intrusive_reclaim.h>
+
+#include <atomic>
+
+namespace CsPointer {
+
+// the slot owns one reference, load() protects the current value with a hazard pointer
+// and then increments only if the object is still alive, Policy must defer destruction
+// through a reclamation domain
+
+template <typename T, typename Policy = CsIntrusiveReclaimPolicy<>>
+class CsAtomicIntrusivePointer
+{
+ public:
+   static_assert(cs_is_reclaim_policy_v<Policy>,
+         "Policy must retire objects to a reclamation domain, use CsIntrusiveReclaimPolicy");
+
+   using pointer      = T *;
+   using element_type = T;
+   using value_type   = CsIntrusivePointer<T, Policy>;
+
+   using Pointer      = pointer;
+   using ElementType  = element_type;
+
+   static constexpr bool is_always_lock_free = std::atomic<T *>::is_always_lock_free;
+
+   constexpr CsAtomicIntrusivePointer() noexcept
+      : m_ptr(nullptr)
+   {
+   }
+
+   constexpr CsAtomicIntrusivePointer(std::nullptr_t) noexcept
+      : m_ptr(nullptr)
+   {
+   }
+
+   CsAtomicIntrusivePointer(value_type desired) noexcept
+      : m_ptr(desired.detach())
+   {
+   }
+
+   CsAtomicIntrusivePointer(const CsAtomicIntrusivePointer &) = delete;
+   CsAtomicIntrusivePointer &operator=(const CsAtomicIntrusivePointer &) = delete;
+
+   ~CsAtomicIntrusivePointer()
+   {
+      T *ptr = m_ptr.load(std::memory_order_relaxed);
+
+      if (ptr != nullptr) {
+         Policy::dec_ref_count(ptr);
+      }
+   }
+
+   CsAtomicIntrusivePointer &operator=(value_type desired) {
+      store(std::move(desired));
+      return *this;
+   }
+
+   operator value_type() const {
+      return load();
+   }
+
+   bool is_lock_free() const noexcept {
+      return m_ptr.is_lock_free();
+   }
+
+   value_type load() const {
+      CsHazardPointer hazard;
+
+      while (true) {
+         T *ptr = hazard.protect(m_ptr);
+
+         if (ptr == nullptr) {
+            return value_type();
+         }
+
+         if (Policy::try_inc_ref_count(ptr)) {
+            return value_type(ptr, CsIntrusiveAdopt);
+         }
+
+         // the slot was changed and the old object released, read the slot again
+      }
+   }
+
+   void store(value_type desired) {
+      T *oldPtr = m_ptr.exchange(desired.detach());
+
+      if (oldPtr != nullptr) {
+         Policy::dec_ref_count(oldPtr);
+      }
+   }
+
+   value_type exchange(value_type desired) {
+      return value_type(m_ptr.exchange(desired.detach()), CsIntrusiveAdopt);
+   }
+
+   bool compare_exchange_strong(value_type &expected, value_type desired) {
+      T *oldPtr = expected.get();
+      T *newPtr = desired.get();
+
+      if (m_ptr.compare_exchange_strong(oldPtr, newPtr)) {
+         // reference held by desired now belongs to the slot, reference held by the slot is released
+         (void) desired.detach();
+
+         if (oldPtr != nullptr) {
+            Policy::dec_ref_count(oldPtr);
+         }
+
+         return true;
+      }
+
+      expected = load();
+      return false;
+   }
+
+   bool compare_exchange_weak(value_type &expected, value_type desired) {
+      return compare_exchange_strong(expected, std::move(desired));
+   }
+
+ private:
+   std::atomic<T *> m_ptr;
+};
+
+}   // end namespace
+
+#endif
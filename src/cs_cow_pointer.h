@@ -0,0 +1,198 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_COW_POINTER_H
+#define LIB_CS_COW_POINTER_H
+
+#include <cs_intrusive_pointer.h>
+
+namespace CsPointer {
+
+// default clone customization point, overload cs_cow_clone() in the namespace of T or
+// provide a member function clone() returning T * to change how a shared object is copied
+
+template <typename T>
+T *cs_cow_clone(const T *ptr)
+{
+   return new T(*ptr);
+}
+
+// implicitly shared value, const access never copies and non-const access copies the
+// object only when it is shared, T must be copyable and typically inherits from CsIntrusiveBase_CM
+
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy>
+class CsCowPointer
+{
+ public:
+   using pointer      = T *;
+   using element_type = T;
+
+   using Pointer      = pointer;
+   using ElementType  = element_type;
+
+   constexpr CsCowPointer() noexcept = default;
+
+   constexpr CsCowPointer(std::nullptr_t) noexcept
+   {
+   }
+
+   explicit CsCowPointer(T *p)
+      : m_ptr(p)
+   {
+   }
+
+   explicit CsCowPointer(CsIntrusivePointer<T, Policy> p) noexcept
+      : m_ptr(std::move(p))
+   {
+   }
+
+   CsCowPointer(const CsCowPointer &other) = default;
+   CsCowPointer &operator=(const CsCowPointer &other) = default;
+
+   CsCowPointer(CsCowPointer &&other) = default;
+   CsCowPointer &operator=(CsCowPointer &&other) = default;
+
+   const T &operator*() const noexcept {
+      return *m_ptr;
+   }
+
+   T &operator*() {
+      detach();
+      return *m_ptr;
+   }
+
+   const T *operator->() const noexcept {
+      return m_ptr.get();
+   }
+
+   T *operator->() {
+      detach();
+      return m_ptr.get();
+   }
+
+   bool operator !() const noexcept {
+      return m_ptr == nullptr;
+   }
+
+   explicit operator bool() const noexcept {
+      return m_ptr != nullptr;
+   }
+
+   void clear() noexcept {
+      reset();
+   }
+
+   const T *constData() const noexcept {
+      return m_ptr.get();
+   }
+
+   const T *data() const noexcept {
+      return m_ptr.get();
+   }
+
+   T *data() {
+      detach();
+      return m_ptr.get();
+   }
+
+   // replaces a shared object with a private copy
+   void detach() {
+      if (m_ptr != nullptr && ! is_unique()) {
+         CsIntrusivePointer<T, Policy> tmp(clone(m_ptr.get()));
+         m_ptr.swap(tmp);
+      }
+   }
+
+   bool is_null() const noexcept {
+      return m_ptr == nullptr;
+   }
+
+   bool is_shared() const noexcept {
+      return m_ptr != nullptr && ! is_unique();
+   }
+
+   void reset() noexcept {
+      m_ptr.reset();
+   }
+
+   void reset(T *p) {
+      m_ptr.reset(p);
+   }
+
+   void swap(CsCowPointer &other) noexcept {
+      m_ptr.swap(other.m_ptr);
+   }
+
+   const CsIntrusivePointer<T, Policy> &toIntrusivePointer() const noexcept {
+      return m_ptr;
+   }
+
+   std::size_t use_count() const noexcept {
+      return m_ptr.use_count();
+   }
+
+   bool operator==(const CsCowPointer &other) const noexcept {
+      return m_ptr == other.m_ptr;
+   }
+
+   bool operator==(std::nullptr_t) const noexcept {
+      return m_ptr == nullptr;
+   }
+
+ private:
+   bool is_unique() const noexcept {
+      if constexpr (requires (const T *ptr) { Policy::is_immortal(ptr); }) {
+         if (Policy::is_immortal(m_ptr.get())) {
+            // frozen objects are shared by definition
+            return false;
+         }
+      }
+
+      return m_ptr.use_count() == 1;
+   }
+
+   static T *clone(const T *ptr) {
+      if constexpr (requires { ptr->clone(); }) {
+         return ptr->clone();
+      } else {
+         return cs_cow_clone(ptr);
+      }
+   }
+
+   CsIntrusivePointer<T, Policy> m_ptr;
+};
+
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy, typename... Args>
+CsCowPointer<T, Policy> make_cow(Args &&... args)
+{
+   return CsCowPointer<T, Policy>(make_intrusive<T, Policy>(std::forward<Args>(args)...));
+}
+
+template <typename T, typename Policy>
+void swap(CsCowPointer<T, Policy> &ptr1, CsCowPointer<T, Policy> &ptr2) noexcept
+{
+   ptr1.swap(ptr2);
+}
+
+template <typename T, typename Policy>
+struct cs_is_trivially_relocatable<CsCowPointer<T, Policy>> : std::true_type {
+};
+
+}   // end namespace
+
+#endif
@@ -0,0 +1,286 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_BIASED_H
+#define LIB_CS_INTRUSIVE_BIASED_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace CsPointer {
+
+class CsIntrusiveBase_Biased;
+class CsIntrusiveBiasedPolicy;
+
+// one record per thread, kept alive by every object which is biased towards the thread
+
+class CsBiasedOwner
+{
+ public:
+   static CsBiasedOwner *current() {
+      thread_local Holder holder;
+      return holder.m_owner;
+   }
+
+   bool has_queued() const noexcept {
+      return m_queue.load(std::memory_order_relaxed) != nullptr;
+   }
+
+   inline void enqueue(const CsIntrusiveBase_Biased *obj);
+   inline void merge_queued();
+
+ private:
+   struct Holder {
+      Holder()
+         : m_owner(new CsBiasedOwner)
+      {
+      }
+
+      ~Holder() {
+         m_owner->m_exited.store(true);
+         m_owner->merge_queued();
+         m_owner->deref();
+      }
+
+      CsBiasedOwner *m_owner;
+   };
+
+   CsBiasedOwner() = default;
+
+   void ref() noexcept {
+      m_refs.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   void deref() noexcept {
+      if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+         delete this;
+      }
+   }
+
+   std::atomic<std::size_t> m_refs = 1;
+   std::atomic<bool> m_exited = false;
+   std::atomic<const CsIntrusiveBase_Biased *> m_queue = nullptr;
+
+   friend class CsIntrusiveBase_Biased;
+};
+
+// the owner thread counts in m_local without atomic read-modify-write operations,
+// all other threads count in m_shared which also stores the Merged and Queued flags
+
+class CsIntrusiveBase_Biased
+{
+ public:
+   CsIntrusiveBase_Biased() = default;
+
+   CsIntrusiveBase_Biased(const CsIntrusiveBase_Biased &) = delete;
+   CsIntrusiveBase_Biased &operator=(const CsIntrusiveBase_Biased &) = delete;
+
+   virtual ~CsIntrusiveBase_Biased() {
+      if (m_owner != nullptr) {
+         m_owner->deref();
+      }
+   }
+
+ private:
+   static constexpr std::intptr_t MergedFlag = 1;
+   static constexpr std::intptr_t QueuedFlag = 2;
+   static constexpr std::intptr_t CountUnit  = 4;
+
+   mutable CsBiasedOwner *m_owner = nullptr;
+   mutable bool m_merged          = false;
+
+   mutable std::atomic<std::intptr_t> m_local  = 0;
+   mutable std::atomic<std::intptr_t> m_shared = 0;
+
+   mutable const CsIntrusiveBase_Biased *m_next = nullptr;
+
+   static std::intptr_t count(std::intptr_t value) {
+      return value >> 2;
+   }
+
+   // returns true if the calling thread is the owner and the count has not been merged
+   bool cs_is_biased(CsBiasedOwner *self) const noexcept {
+      if (m_owner == nullptr) {
+         // first reference, no other thread can see this object yet
+         m_owner = self;
+         m_owner->ref();
+      }
+
+      if (m_owner != self) {
+         return false;
+      }
+
+      if (self->has_queued()) {
+         self->merge_queued();
+      }
+
+      return ! m_merged;
+   }
+
+   void cs_inc_ref_count() const noexcept {
+      if (cs_is_biased(CsBiasedOwner::current())) {
+         m_local.store(m_local.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+      } else {
+         m_shared.fetch_add(CountUnit, std::memory_order_relaxed);
+      }
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action) const {
+      bool isLast = false;
+
+      if (cs_is_biased(CsBiasedOwner::current())) {
+         std::intptr_t local = m_local.load(std::memory_order_relaxed) - 1;
+         m_local.store(local, std::memory_order_relaxed);
+
+         if (local == 0) {
+            isLast = cs_merge();
+         }
+
+      } else {
+         std::intptr_t oldValue = m_shared.load(std::memory_order_relaxed);
+         std::intptr_t newValue;
+
+         do {
+            newValue = oldValue - CountUnit;
+
+            if ((oldValue & MergedFlag) == 0 && count(newValue) < 0) {
+               // owner holds references which were released on this thread
+               newValue |= QueuedFlag;
+            }
+
+         } while (! m_shared.compare_exchange_weak(oldValue, newValue, std::memory_order_acq_rel));
+
+         if ((oldValue & QueuedFlag) == 0 && (newValue & QueuedFlag) != 0) {
+            m_owner->enqueue(this);
+
+         } else if ((oldValue & (MergedFlag | QueuedFlag)) == MergedFlag && count(oldValue) == 1) {
+            isLast = true;
+         }
+      }
+
+      if (isLast && action != CsIntrusiveAction::NoDelete) {
+         delete this;
+      }
+
+      return isLast;
+   }
+
+   std::size_t cs_get_ref_count() const {
+      return count(m_shared.load(std::memory_order_acquire)) + m_local.load(std::memory_order_relaxed);
+   }
+
+   // called on the owner thread, returns true if the combined count is zero
+   bool cs_merge() const {
+      std::intptr_t local = m_local.load(std::memory_order_relaxed);
+      m_local.store(0, std::memory_order_relaxed);
+      m_merged = true;
+
+      std::intptr_t oldValue = m_shared.fetch_add(local * CountUnit + MergedFlag, std::memory_order_acq_rel);
+
+      // a queued object is released by CsBiasedOwner::merge_queued()
+      return (oldValue & QueuedFlag) == 0 && count(oldValue) + local == 0;
+   }
+
+   // called by the thread which removed this object from the queue
+   bool cs_merge_queued() const {
+      if (! m_merged) {
+         cs_merge();
+      }
+
+      std::intptr_t oldValue = m_shared.fetch_and(~QueuedFlag, std::memory_order_acq_rel);
+      return count(oldValue) == 0;
+   }
+
+   void cs_unbias() const {
+      if (m_owner == CsBiasedOwner::current() && ! m_merged) {
+         if (cs_merge()) {
+            delete this;
+         }
+      }
+   }
+
+   friend class CsBiasedOwner;
+   friend class CsIntrusiveDefaultPolicy;
+   friend class CsIntrusiveBiasedPolicy;
+};
+
+void CsBiasedOwner::enqueue(const CsIntrusiveBase_Biased *obj)
+{
+   const CsIntrusiveBase_Biased *head = m_queue.load(std::memory_order_relaxed);
+
+   do {
+      obj->m_next = head;
+   } while (! m_queue.compare_exchange_weak(head, obj));
+
+   if (m_exited.load()) {
+      // owner thread has finished, merge on this thread
+      merge_queued();
+   }
+}
+
+void CsBiasedOwner::merge_queued()
+{
+   const CsIntrusiveBase_Biased *obj = m_queue.exchange(nullptr);
+
+   while (obj != nullptr) {
+      const CsIntrusiveBase_Biased *next = obj->m_next;
+
+      if (obj->cs_merge_queued()) {
+         delete obj;
+      }
+
+      obj = next;
+   }
+}
+
+class CsIntrusiveBiasedPolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      ptr->cs_inc_ref_count();
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      return ptr->cs_dec_ref_count(action);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return ptr->cs_get_ref_count();
+   }
+
+   // called by the owner thread before ownership is handed to another thread
+   template <typename T>
+   static void unbias(const T *ptr) {
+      ptr->cs_unbias();
+   }
+
+   // merges objects whose references were released by other threads
+   static void merge_queued() {
+      CsBiasedOwner::current()->merge_queued();
+   }
+};
+
+}   // end namespace
+
+#endif
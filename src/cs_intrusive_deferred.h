@@ -0,0 +1,213 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_DEFERRED_H
+#define LIB_CS_INTRUSIVE_DEFERRED_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace CsPointer {
+
+// objects released to the queue are destroyed by drain() or by the reclaimer thread,
+// objects released while the queue is draining are destroyed by the same drain() call
+
+class CsDeferredQueue
+{
+ public:
+   using Deleter = void (*)(const void *);
+
+   CsDeferredQueue() = default;
+
+   CsDeferredQueue(const CsDeferredQueue &) = delete;
+   CsDeferredQueue &operator=(const CsDeferredQueue &) = delete;
+
+   ~CsDeferredQueue() {
+      stop();
+      drain();
+   }
+
+   static CsDeferredQueue &global() {
+      static CsDeferredQueue queue;
+      return queue;
+   }
+
+   void push(const void *ptr, Deleter deleter) {
+      Node *node = new Node{ptr, deleter, nullptr};
+      Node *head = m_head.load(std::memory_order_relaxed);
+
+      do {
+         node->m_next = head;
+      } while (! m_head.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+      if (head == nullptr && m_running.load(std::memory_order_relaxed)) {
+         // queue was empty, wake the reclaimer thread
+         m_signal.fetch_add(1, std::memory_order_release);
+         m_signal.notify_one();
+      }
+   }
+
+   template <typename T>
+   void push(const T *ptr) {
+      push(ptr, [] (const void *p) { delete static_cast<const T *>(p); });
+   }
+
+   // destroys every queued object, returns the number of objects destroyed
+   std::size_t drain() {
+      std::size_t count = 0;
+      Node *node = m_head.exchange(nullptr, std::memory_order_acquire);
+
+      while (node != nullptr) {
+         while (node != nullptr) {
+            Node *next = node->m_next;
+
+            node->m_deleter(node->m_ptr);
+            delete node;
+
+            node = next;
+            ++count;
+         }
+
+         node = m_head.exchange(nullptr, std::memory_order_acquire);
+      }
+
+      return count;
+   }
+
+   bool empty() const noexcept {
+      return m_head.load(std::memory_order_relaxed) == nullptr;
+   }
+
+   // starts a background thread which destroys queued objects
+   void start() {
+      std::lock_guard<std::mutex> lock(m_threadMutex);
+
+      if (m_running.load()) {
+         return;
+      }
+
+      m_running.store(true);
+
+      m_thread = std::thread([this] () {
+         while (m_running.load(std::memory_order_relaxed)) {
+            std::uint32_t signal = m_signal.load(std::memory_order_acquire);
+
+            if (drain() == 0 && m_running.load(std::memory_order_relaxed)) {
+               m_signal.wait(signal, std::memory_order_acquire);
+            }
+         }
+      });
+   }
+
+   void stop() {
+      std::lock_guard<std::mutex> lock(m_threadMutex);
+
+      if (! m_running.load()) {
+         return;
+      }
+
+      m_running.store(false);
+
+      m_signal.fetch_add(1, std::memory_order_release);
+      m_signal.notify_one();
+
+      m_thread.join();
+   }
+
+ private:
+   struct Node {
+      const void *m_ptr;
+      Deleter m_deleter;
+
+      Node *m_next;
+   };
+
+   std::atomic<Node *> m_head = nullptr;
+
+   std::atomic<bool> m_running = false;
+   std::atomic<std::uint32_t> m_signal = 0;
+
+   std::mutex m_threadMutex;
+   std::thread m_thread;
+};
+
+// releasing the last reference queues the object on the global queue instead of deleting it
+
+template <typename Policy = CsIntrusiveDefaultPolicy>
+class CsIntrusiveDeferredPolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      Policy::inc_ref_count(ptr);
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      bool isLast = Policy::dec_ref_count(ptr, CsIntrusiveAction::NoDelete);
+
+      if (isLast && action != CsIntrusiveAction::NoDelete) {
+         CsDeferredQueue::global().push(ptr);
+      }
+
+      return isLast;
+   }
+
+   // called by release_intrusive_range() for objects which reached zero
+   template <typename T>
+   static void destroy(const T *ptr) {
+      CsDeferredQueue::global().push(ptr);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return Policy::get_ref_count(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::try_inc_ref_count(p); }
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      return Policy::try_inc_ref_count(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::try_take_unique(p); }
+   static bool try_take_unique(const T *ptr) noexcept {
+      return Policy::try_take_unique(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::freeze(p); }
+   static void freeze(const T *ptr) noexcept {
+      Policy::freeze(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::is_immortal(p); }
+   static bool is_immortal(const T *ptr) noexcept {
+      return Policy::is_immortal(ptr);
+   }
+};
+
+}   // end namespace
+
+#endif
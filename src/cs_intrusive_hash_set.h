@@ -0,0 +1,363 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_HASH_SET_H
+#define LIB_CS_INTRUSIVE_HASH_SET_H
+
+#include <cs_intrusive_pointer.h>
+#include <cs_intrusive_ref.h>
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CsPointer {
+
+template <typename T, typename Hash, typename Equal, typename Policy, typename Tag>
+class CsIntrusiveHashSet;
+
+// base class which provides the bucket links and the cached hash for one CsIntrusiveHashSet
+
+template <typename Tag = void>
+class CsIntrusiveHashSetHook
+{
+ public:
+   CsIntrusiveHashSetHook() = default;
+
+   // a copy is not a member of any set
+   CsIntrusiveHashSetHook(const CsIntrusiveHashSetHook &) noexcept
+   {
+   }
+
+   CsIntrusiveHashSetHook &operator=(const CsIntrusiveHashSetHook &) noexcept {
+      return *this;
+   }
+
+   ~CsIntrusiveHashSetHook() {
+      assert(! is_linked() && "Object destroyed while it is a member of a CsIntrusiveHashSet");
+   }
+
+   bool is_linked() const noexcept {
+      return m_pprev != nullptr;
+   }
+
+ private:
+   CsIntrusiveHashSetHook *m_next   = nullptr;
+   CsIntrusiveHashSetHook **m_pprev = nullptr;
+
+   std::size_t m_hash = 0;
+
+   template <typename T, typename Hash, typename Equal, typename Policy, typename U>
+   friend class CsIntrusiveHashSet;
+};
+
+// chained hash set, the set holds one reference to each element, the bucket array is only
+// allocated when the set grows so inserting into a reserved set never allocates
+
+template <typename T, typename Hash = std::hash<T>, typename Equal = std::equal_to<>,
+      typename Policy = CsIntrusiveDefaultPolicy, typename Tag = void>
+class CsIntrusiveHashSet
+{
+   using Hook = CsIntrusiveHashSetHook<Tag>;
+
+ public:
+   using value_type = T;
+   using size_type  = std::size_t;
+
+   class const_iterator
+   {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const T *;
+      using reference         = const T &;
+
+      const_iterator() noexcept
+         : m_bucket(nullptr), m_bucketEnd(nullptr), m_hook(nullptr)
+      {
+      }
+
+      const T &operator*() const noexcept {
+         return *static_cast<const T *>(m_hook);
+      }
+
+      const T *operator->() const noexcept {
+         return static_cast<const T *>(m_hook);
+      }
+
+      const_iterator &operator++() noexcept {
+         m_hook = m_hook->m_next;
+         skip_empty();
+
+         return *this;
+      }
+
+      const_iterator operator++(int) noexcept {
+         const_iterator retval = *this;
+         ++(*this);
+
+         return retval;
+      }
+
+      bool operator==(const const_iterator &other) const noexcept {
+         return m_hook == other.m_hook;
+      }
+
+    private:
+      const_iterator(Hook *const *bucket, Hook *const *bucketEnd) noexcept
+         : m_bucket(bucket), m_bucketEnd(bucketEnd), m_hook(nullptr)
+      {
+         if (m_bucket != m_bucketEnd) {
+            m_hook = *m_bucket;
+            skip_empty();
+         }
+      }
+
+      void skip_empty() noexcept {
+         while (m_hook == nullptr && m_bucket != m_bucketEnd) {
+            ++m_bucket;
+
+            if (m_bucket != m_bucketEnd) {
+               m_hook = *m_bucket;
+            }
+         }
+      }
+
+      Hook *const *m_bucket;
+      Hook *const *m_bucketEnd;
+      const Hook *m_hook;
+
+      friend class CsIntrusiveHashSet;
+   };
+
+   using iterator = const_iterator;
+
+   CsIntrusiveHashSet() = default;
+
+   explicit CsIntrusiveHashSet(size_type bucketCount) {
+      reserve(bucketCount);
+   }
+
+   CsIntrusiveHashSet(const CsIntrusiveHashSet &) = delete;
+   CsIntrusiveHashSet &operator=(const CsIntrusiveHashSet &) = delete;
+
+   // the bucket array is moved, each head still points into the same storage
+   CsIntrusiveHashSet(CsIntrusiveHashSet &&other) noexcept
+      : m_buckets(std::move(other.m_buckets)), m_size(other.m_size)
+   {
+      other.m_buckets.clear();
+      other.m_size = 0;
+   }
+
+   CsIntrusiveHashSet &operator=(CsIntrusiveHashSet &&other) {
+      if (this != &other) {
+         clear();
+
+         m_buckets = std::move(other.m_buckets);
+         m_size    = other.m_size;
+
+         other.m_buckets.clear();
+         other.m_size = 0;
+      }
+
+      return *this;
+   }
+
+   ~CsIntrusiveHashSet() {
+      clear();
+   }
+
+   const_iterator begin() const noexcept {
+      return const_iterator(m_buckets.data(), m_buckets.data() + m_buckets.size());
+   }
+
+   const_iterator end() const noexcept {
+      return const_iterator();
+   }
+
+   bool empty() const noexcept {
+      return m_size == 0;
+   }
+
+   size_type size() const noexcept {
+      return m_size;
+   }
+
+   size_type bucket_count() const noexcept {
+      return m_buckets.size();
+   }
+
+   // bucket count is rounded up to a power of two
+   void reserve(size_type count) {
+      size_type bucketCount = MinBucketCount;
+
+      while (bucketCount < count) {
+         bucketCount *= 2;
+      }
+
+      if (bucketCount > m_buckets.size()) {
+         rehash(bucketCount);
+      }
+   }
+
+   // takes over the reference held by ptr, returns false if an equal element is already present
+   bool insert(CsIntrusivePointer<T, Policy> ptr) {
+      assert(ptr != nullptr && "CsIntrusiveHashSet can not contain a null pointer");
+
+      std::size_t hash = Hash()(*ptr);
+
+      if (find_hook(*ptr, hash) != nullptr) {
+         return false;
+      }
+
+      if (m_size >= m_buckets.size()) {
+         reserve(m_size + 1);
+      }
+
+      Hook *hook = static_cast<Hook *>(ptr.detach());
+      assert(hook->m_pprev == nullptr && "Object is already a member of a CsIntrusiveHashSet");
+
+      hook->m_hash = hash;
+      link(hook, m_buckets[bucket_index(hash)]);
+
+      ++m_size;
+
+      return true;
+   }
+
+   template <typename K>
+   CsIntrusiveRef<T, Policy> find(const K &key) const {
+      const Hook *hook = find_hook(key, Hash()(key));
+      return CsIntrusiveRef<T, Policy>(static_cast<T *>(const_cast<Hook *>(hook)));
+   }
+
+   template <typename K>
+   bool contains(const K &key) const {
+      return find_hook(key, Hash()(key)) != nullptr;
+   }
+
+   // removes the element equal to key, returns false if no element was found
+   template <typename K>
+   bool remove(const K &key) {
+      const Hook *hook = find_hook(key, Hash()(key));
+
+      if (hook == nullptr) {
+         return false;
+      }
+
+      take(*static_cast<const T *>(hook));
+
+      return true;
+   }
+
+   // O(1), obj must be a member of this set
+   void erase(const T &obj) {
+      take(obj);
+   }
+
+   // unlinks obj and returns the reference which was held by the set
+   CsIntrusivePointer<T, Policy> take(const T &obj) noexcept {
+      Hook *hook = static_cast<Hook *>(const_cast<T *>(&obj));
+
+      *hook->m_pprev = hook->m_next;
+
+      if (hook->m_next != nullptr) {
+         hook->m_next->m_pprev = hook->m_pprev;
+      }
+
+      hook->m_next  = nullptr;
+      hook->m_pprev = nullptr;
+
+      --m_size;
+
+      return CsIntrusivePointer<T, Policy>(const_cast<T *>(&obj), CsIntrusiveAdopt);
+   }
+
+   void clear() {
+      for (Hook *&head : m_buckets) {
+         while (head != nullptr) {
+            take(*static_cast<T *>(head));
+         }
+      }
+   }
+
+ private:
+   static constexpr size_type MinBucketCount = 8;
+
+   size_type bucket_index(std::size_t hash) const noexcept {
+      return (hash ^ (hash >> 16)) & (m_buckets.size() - 1);
+   }
+
+   static void link(Hook *hook, Hook *&head) noexcept {
+      hook->m_next  = head;
+      hook->m_pprev = &head;
+
+      if (head != nullptr) {
+         head->m_pprev = &hook->m_next;
+      }
+
+      head = hook;
+   }
+
+   template <typename K>
+   const Hook *find_hook(const K &key, std::size_t hash) const {
+      if (m_buckets.empty()) {
+         return nullptr;
+      }
+
+      for (const Hook *hook = m_buckets[bucket_index(hash)]; hook != nullptr; hook = hook->m_next) {
+         if (hook->m_hash == hash && Equal()(*static_cast<const T *>(hook), key)) {
+            return hook;
+         }
+      }
+
+      return nullptr;
+   }
+
+   void rehash(size_type bucketCount) {
+      std::vector<Hook *> oldBuckets(bucketCount, nullptr);
+      oldBuckets.swap(m_buckets);
+
+      for (Hook *hook : oldBuckets) {
+         while (hook != nullptr) {
+            Hook *next = hook->m_next;
+            link(hook, m_buckets[bucket_index(hook->m_hash)]);
+
+            hook = next;
+         }
+      }
+   }
+
+   std::vector<Hook *> m_buckets;
+   size_type m_size = 0;
+};
+
+template <typename T, typename Hash, typename Equal, typename Policy, typename Tag>
+void swap(CsIntrusiveHashSet<T, Hash, Equal, Policy, Tag> &set1, CsIntrusiveHashSet<T, Hash, Equal, Policy, Tag> &set2)
+{
+   std::swap(set1, set2);
+}
+
+}   // end namespace
+
+#endif
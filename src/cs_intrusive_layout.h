@@ -0,0 +1,269 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_LAYOUT_H
+#define LIB_CS_INTRUSIVE_LAYOUT_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace CsPointer {
+
+inline constexpr std::size_t CsCacheLineSize = 64;
+
+// the vtable pointer occupies the first cache line of the object and the count has a cache
+// line of its own, the members of the derived class start on the third cache line
+
+class alignas(CsCacheLineSize) CsIntrusiveBase_Aligned
+{
+ public:
+   CsIntrusiveBase_Aligned() = default;
+
+   CsIntrusiveBase_Aligned(const CsIntrusiveBase_Aligned &) = delete;
+   CsIntrusiveBase_Aligned &operator=(const CsIntrusiveBase_Aligned &) = delete;
+
+   virtual ~CsIntrusiveBase_Aligned() = default;
+
+ private:
+   // readers calling a virtual function do not share a cache line with the count
+   struct alignas(CsCacheLineSize) Counter {
+      std::atomic<std::size_t> m_count = 0;
+   };
+
+   mutable Counter m_counter;
+
+   void cs_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_counter.m_count.fetch_add(1, order);
+   }
+
+   void cs_inc_ref_count(std::size_t n, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_counter.m_count.fetch_add(n, order);
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      return cs_dec_ref_count(1, action, order);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      std::size_t old_count = m_counter.m_count.fetch_sub(n, order);
+
+      if (old_count == n && (order == std::memory_order_release || order == std::memory_order_relaxed)) {
+         // pairs with the release decrement of every other owner
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
+      if (old_count == n && action != CsIntrusiveAction::NoDelete) {
+         delete this;
+      }
+
+      return old_count == n;
+   }
+
+   bool cs_try_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      std::size_t count = m_counter.m_count.load(std::memory_order_relaxed);
+
+      do {
+         if (count == 0) {
+            return false;
+         }
+
+      } while (! m_counter.m_count.compare_exchange_weak(count, count + 1, order, std::memory_order_relaxed));
+
+      return true;
+   }
+
+   bool cs_try_take_unique() const noexcept {
+      std::size_t count = 1;
+      return m_counter.m_count.compare_exchange_strong(count, 0, std::memory_order_acquire, std::memory_order_relaxed);
+   }
+
+   std::size_t cs_get_ref_count(std::memory_order order = std::memory_order_seq_cst) const {
+      return m_counter.m_count.load(order);
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+
+   template <std::memory_order IncOrder, std::memory_order DecOrder>
+   friend class CsIntrusiveOrderPolicy;
+};
+
+class CsIntrusiveBase_Header;
+
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy, typename... Args>
+   requires std::is_base_of_v<CsIntrusiveBase_Header, T>
+CsIntrusivePointer<T, Policy> make_intrusive(Args &&... args);
+
+// only make_intrusive() can create a key, every constructor of a class derived from
+// CsIntrusiveBase_Header must accept one and pass it to the base class
+
+class CsIntrusiveHeaderKey
+{
+ public:
+   CsIntrusiveHeaderKey(const CsIntrusiveHeaderKey &) = delete;
+   CsIntrusiveHeaderKey &operator=(const CsIntrusiveHeaderKey &) = delete;
+
+ private:
+   CsIntrusiveHeaderKey() = default;
+
+   template <typename T, typename Policy, typename... Args>
+      requires std::is_base_of_v<CsIntrusiveBase_Header, T>
+   friend CsIntrusivePointer<T, Policy> make_intrusive(Args &&... args);
+};
+
+// the count is stored on its own cache line directly in front of the most derived object,
+// objects must be created with make_intrusive() so the class allocation functions reserve
+// the header, stack objects, members, placement new, array new and allocate_intrusive()
+// are rejected at compile time
+
+class CsIntrusiveBase_Header
+{
+ public:
+   explicit CsIntrusiveBase_Header(const CsIntrusiveHeaderKey &) noexcept {
+   }
+
+   CsIntrusiveBase_Header(const CsIntrusiveBase_Header &) = delete;
+   CsIntrusiveBase_Header &operator=(const CsIntrusiveBase_Header &) = delete;
+
+   virtual ~CsIntrusiveBase_Header() = default;
+
+   static void *operator new(std::size_t size) {
+      return allocate(size, CsCacheLineSize);
+   }
+
+   static void *operator new(std::size_t size, std::align_val_t align) {
+      return allocate(size, std::max(std::size_t(align), CsCacheLineSize));
+   }
+
+   static void operator delete(void *ptr) noexcept {
+      deallocate(ptr, CsCacheLineSize);
+   }
+
+   static void operator delete(void *ptr, std::align_val_t align) noexcept {
+      deallocate(ptr, std::max(std::size_t(align), CsCacheLineSize));
+   }
+
+   // every element of an array would share one header
+   static void *operator new[](std::size_t size) = delete;
+   static void *operator new[](std::size_t size, std::align_val_t align) = delete;
+
+ private:
+   struct alignas(CsCacheLineSize) Header {
+      std::atomic<std::size_t> m_count = 0;
+   };
+
+   // headerSize is a multiple of the cache line size so the object keeps its alignment
+   static void *allocate(std::size_t size, std::size_t headerSize) {
+      char *memory = static_cast<char *>(::operator new(headerSize + size, std::align_val_t(headerSize)));
+      char *object = memory + headerSize;
+
+      ::new (static_cast<void *>(object - sizeof(Header))) Header;
+
+      return object;
+   }
+
+   static void deallocate(void *ptr, std::size_t headerSize) noexcept {
+      if (ptr == nullptr) {
+         return;
+      }
+
+      char *object = static_cast<char *>(ptr);
+      reinterpret_cast<Header *>(object - sizeof(Header))->~Header();
+
+      ::operator delete(object - headerSize, std::align_val_t(headerSize));
+   }
+
+   // the header precedes the most derived object, not this base subobject
+   std::atomic<std::size_t> &cs_count() const noexcept {
+      const char *object = static_cast<const char *>(dynamic_cast<const void *>(this));
+      return std::launder(reinterpret_cast<Header *>(const_cast<char *>(object) - sizeof(Header)))->m_count;
+   }
+
+   void cs_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      cs_count().fetch_add(1, order);
+   }
+
+   void cs_inc_ref_count(std::size_t n, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      cs_count().fetch_add(n, order);
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      return cs_dec_ref_count(1, action, order);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      std::size_t old_count = cs_count().fetch_sub(n, order);
+
+      if (old_count == n && (order == std::memory_order_release || order == std::memory_order_relaxed)) {
+         // pairs with the release decrement of every other owner
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
+      if (old_count == n && action != CsIntrusiveAction::NoDelete) {
+         delete this;
+      }
+
+      return old_count == n;
+   }
+
+   bool cs_try_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      std::atomic<std::size_t> &counter = cs_count();
+      std::size_t count = counter.load(std::memory_order_relaxed);
+
+      do {
+         if (count == 0) {
+            return false;
+         }
+
+      } while (! counter.compare_exchange_weak(count, count + 1, order, std::memory_order_relaxed));
+
+      return true;
+   }
+
+   bool cs_try_take_unique() const noexcept {
+      std::size_t count = 1;
+      return cs_count().compare_exchange_strong(count, 0, std::memory_order_acquire, std::memory_order_relaxed);
+   }
+
+   std::size_t cs_get_ref_count(std::memory_order order = std::memory_order_seq_cst) const {
+      return cs_count().load(order);
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+
+   template <std::memory_order IncOrder, std::memory_order DecOrder>
+   friend class CsIntrusiveOrderPolicy;
+};
+
+// T is constructed with a CsIntrusiveHeaderKey followed by args
+
+template <typename T, typename Policy, typename... Args>
+   requires std::is_base_of_v<CsIntrusiveBase_Header, T>
+CsIntrusivePointer<T, Policy> make_intrusive(Args &&... args)
+{
+   return CsIntrusivePointer<T, Policy>(new T(CsIntrusiveHeaderKey(), std::forward<Args>(args)...));
+}
+
+}   // end namespace
+
+#endif
@@ -0,0 +1,335 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_LIST_H
+#define LIB_CS_INTRUSIVE_LIST_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace CsPointer {
+
+template <typename T, typename Policy, typename Tag>
+class CsIntrusiveList;
+
+// base class which provides the links for one CsIntrusiveList, an object can be a member
+// of several lists by deriving from hooks with different tags
+
+template <typename Tag = void>
+class CsIntrusiveListHook
+{
+ public:
+   CsIntrusiveListHook() = default;
+
+   // a copy is not a member of any list
+   CsIntrusiveListHook(const CsIntrusiveListHook &) noexcept
+   {
+   }
+
+   CsIntrusiveListHook &operator=(const CsIntrusiveListHook &) noexcept {
+      return *this;
+   }
+
+   ~CsIntrusiveListHook() {
+      assert(! is_linked() && "Object destroyed while it is a member of a CsIntrusiveList");
+   }
+
+   bool is_linked() const noexcept {
+      return m_next != nullptr;
+   }
+
+ private:
+   CsIntrusiveListHook *m_prev = nullptr;
+   CsIntrusiveListHook *m_next = nullptr;
+
+   template <typename T, typename Policy, typename U>
+   friend class CsIntrusiveList;
+};
+
+// circular doubly linked list, the list holds one reference to each element and inserting
+// or unlinking an element never allocates
+
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy, typename Tag = void>
+class CsIntrusiveList
+{
+   using Hook = CsIntrusiveListHook<Tag>;
+
+ public:
+   using value_type      = T;
+   using size_type       = std::size_t;
+   using reference       = T &;
+   using const_reference = const T &;
+
+   template <typename V, typename H>
+   class Iterator
+   {
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type        = std::remove_const_t<V>;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = V *;
+      using reference         = V &;
+
+      Iterator() noexcept
+         : m_hook(nullptr)
+      {
+      }
+
+      // allow iterator to const_iterator conversion
+      template <typename V2, typename H2>
+      Iterator(const Iterator<V2, H2> &other) noexcept
+         : m_hook(other.m_hook)
+      {
+      }
+
+      V &operator*() const noexcept {
+         return *static_cast<V *>(m_hook);
+      }
+
+      V *operator->() const noexcept {
+         return static_cast<V *>(m_hook);
+      }
+
+      Iterator &operator++() noexcept {
+         m_hook = m_hook->m_next;
+         return *this;
+      }
+
+      Iterator operator++(int) noexcept {
+         Iterator retval = *this;
+         m_hook = m_hook->m_next;
+
+         return retval;
+      }
+
+      Iterator &operator--() noexcept {
+         m_hook = m_hook->m_prev;
+         return *this;
+      }
+
+      Iterator operator--(int) noexcept {
+         Iterator retval = *this;
+         m_hook = m_hook->m_prev;
+
+         return retval;
+      }
+
+      template <typename V2, typename H2>
+      bool operator==(const Iterator<V2, H2> &other) const noexcept {
+         return m_hook == other.m_hook;
+      }
+
+    private:
+      explicit Iterator(H *hook) noexcept
+         : m_hook(hook)
+      {
+      }
+
+      H *m_hook;
+
+      template <typename V2, typename H2>
+      friend class Iterator;
+
+      friend class CsIntrusiveList;
+   };
+
+   using iterator       = Iterator<T, Hook>;
+   using const_iterator = Iterator<const T, const Hook>;
+
+   CsIntrusiveList() noexcept {
+      m_root.m_prev = &m_root;
+      m_root.m_next = &m_root;
+   }
+
+   CsIntrusiveList(const CsIntrusiveList &) = delete;
+   CsIntrusiveList &operator=(const CsIntrusiveList &) = delete;
+
+   CsIntrusiveList(CsIntrusiveList &&other) noexcept
+      : CsIntrusiveList()
+   {
+      swap(other);
+   }
+
+   CsIntrusiveList &operator=(CsIntrusiveList &&other) {
+      CsIntrusiveList tmp(std::move(other));
+      swap(tmp);
+
+      return *this;
+   }
+
+   ~CsIntrusiveList() {
+      clear();
+
+      // leave the sentinel unlinked for the hook destructor
+      m_root.m_prev = nullptr;
+      m_root.m_next = nullptr;
+   }
+
+   iterator begin() noexcept {
+      return iterator(m_root.m_next);
+   }
+
+   const_iterator begin() const noexcept {
+      return const_iterator(m_root.m_next);
+   }
+
+   iterator end() noexcept {
+      return iterator(&m_root);
+   }
+
+   const_iterator end() const noexcept {
+      return const_iterator(&m_root);
+   }
+
+   T &front() noexcept {
+      return *begin();
+   }
+
+   T &back() noexcept {
+      return *iterator(m_root.m_prev);
+   }
+
+   bool empty() const noexcept {
+      return m_size == 0;
+   }
+
+   size_type size() const noexcept {
+      return m_size;
+   }
+
+   // obj must be a member of this list
+   iterator iterator_to(T &obj) noexcept {
+      return iterator(static_cast<Hook *>(&obj));
+   }
+
+   void push_front(CsIntrusivePointer<T, Policy> ptr) {
+      insert(begin(), std::move(ptr));
+   }
+
+   void push_back(CsIntrusivePointer<T, Policy> ptr) {
+      insert(end(), std::move(ptr));
+   }
+
+   // takes over the reference held by ptr, obj must not be a member of a list with the same tag
+   iterator insert(const_iterator pos, CsIntrusivePointer<T, Policy> ptr) {
+      assert(ptr != nullptr && "CsIntrusiveList can not contain a null pointer");
+
+      Hook *hook = static_cast<Hook *>(ptr.detach());
+      assert(hook->m_next == nullptr && "Object is already a member of a CsIntrusiveList");
+
+      Hook *next = const_cast<Hook *>(pos.m_hook);
+      Hook *prev = next->m_prev;
+
+      hook->m_prev = prev;
+      hook->m_next = next;
+      prev->m_next = hook;
+      next->m_prev = hook;
+
+      ++m_size;
+
+      return iterator(hook);
+   }
+
+   void pop_front() {
+      erase(begin());
+   }
+
+   void pop_back() {
+      erase(iterator(m_root.m_prev));
+   }
+
+   iterator erase(const_iterator pos) {
+      Hook *next = pos.m_hook->m_next;
+      take(*static_cast<T *>(const_cast<Hook *>(pos.m_hook)));
+
+      return iterator(next);
+   }
+
+   // O(1), obj must be a member of this list
+   void erase(T &obj) {
+      take(obj);
+   }
+
+   // unlinks obj and returns the reference which was held by the list
+   CsIntrusivePointer<T, Policy> take(T &obj) noexcept {
+      Hook *hook = static_cast<Hook *>(&obj);
+
+      hook->m_prev->m_next = hook->m_next;
+      hook->m_next->m_prev = hook->m_prev;
+      hook->m_prev = nullptr;
+      hook->m_next = nullptr;
+
+      --m_size;
+
+      return CsIntrusivePointer<T, Policy>(&obj, CsIntrusiveAdopt);
+   }
+
+   void clear() {
+      while (! empty()) {
+         pop_front();
+      }
+   }
+
+   void swap(CsIntrusiveList &other) noexcept {
+      Hook *first1 = m_root.m_next;
+      Hook *last1  = m_root.m_prev;
+      Hook *first2 = other.m_root.m_next;
+      Hook *last2  = other.m_root.m_prev;
+
+      if (m_size == 0) {
+         first1 = &other.m_root;
+         last1  = &other.m_root;
+      }
+
+      if (other.m_size == 0) {
+         first2 = &m_root;
+         last2  = &m_root;
+      }
+
+      m_root.m_next = first2;
+      m_root.m_prev = last2;
+      first2->m_prev = &m_root;
+      last2->m_next  = &m_root;
+
+      other.m_root.m_next = first1;
+      other.m_root.m_prev = last1;
+      first1->m_prev = &other.m_root;
+      last1->m_next  = &other.m_root;
+
+      std::swap(m_size, other.m_size);
+   }
+
+ private:
+   Hook m_root;
+   size_type m_size = 0;
+};
+
+template <typename T, typename Policy, typename Tag>
+void swap(CsIntrusiveList<T, Policy, Tag> &list1, CsIntrusiveList<T, Policy, Tag> &list2) noexcept
+{
+   list1.swap(list2);
+}
+
+}   // end namespace
+
+#endif
@@ -19,8 +19,22 @@
 #ifndef LIB_CS_INTRUSIVE_POINTER_H
 #define LIB_CS_INTRUSIVE_POINTER_H
 
+#include <cs_pointer_traits.h>
+
+#include <algorithm>
 #include <atomic>
+#include <cassert>
+#include <concepts>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
 
 namespace CsPointer {
 
@@ -29,100 +43,761 @@ enum class CsIntrusiveAction {
    NoDelete,
 };
 
+template <std::memory_order IncOrder, std::memory_order DecOrder>
+class CsIntrusiveOrderPolicy;
+
+class CsIntrusiveSingleThreadPolicy;
+
+// passed to a CsIntrusivePointer to take over an existing reference without incrementing the count
+
+struct CsIntrusiveAdoptTag {
+   explicit CsIntrusiveAdoptTag() = default;
+};
+
+inline constexpr CsIntrusiveAdoptTag CsIntrusiveAdopt{};
+
+// debug builds record the first thread which touches the reference count, the member is
+// present in every build so the layout does not depend on NDEBUG
+
+class CsIntrusiveThreadCheck
+{
+ public:
+   void check() const noexcept {
+#ifndef NDEBUG
+      std::thread::id current = std::this_thread::get_id();
+      std::thread::id owner   = std::thread::id();
+
+      if (! m_thread.compare_exchange_strong(owner, current, std::memory_order_relaxed)) {
+         assert(owner == current && "Reference count of a single threaded object was accessed from a second thread");
+      }
+#endif
+   }
+
+ private:
+   mutable std::atomic<std::thread::id> m_thread;
+};
+
 class CsIntrusiveBase
 {
  public:
    virtual ~CsIntrusiveBase() = default;
 
  private:
+   static constexpr std::size_t ImmortalFlag = std::size_t(1) << (std::numeric_limits<std::size_t>::digits - 1);
+
+   mutable std::atomic<std::size_t> m_count = 0;
+
+   void cs_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_count.fetch_add(1, order);
+   }
+
+   void cs_inc_ref_count(std::size_t n, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_count.fetch_add(n, order);
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      return cs_dec_ref_count(1, action, order);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      std::size_t old_count = m_count.fetch_sub(n, order);
+
+      if (old_count == n && (order == std::memory_order_release || order == std::memory_order_relaxed)) {
+         // pairs with the release decrement of every other owner
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
+      if (action != CsIntrusiveAction::NoDelete) {
+         if (old_count == n) {
+            delete this;
+         }
+      }
+
+      return old_count == n;
+   }
+
+   bool cs_try_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      std::size_t count = m_count.load(std::memory_order_relaxed);
+
+      do {
+         if (count == 0) {
+            return false;
+         }
+
+      } while (! m_count.compare_exchange_weak(count, count + 1, order, std::memory_order_relaxed));
+
+      return true;
+   }
+
+   // succeeds only if the caller holds the only reference, the count is left at zero
+   bool cs_try_take_unique() const noexcept {
+      std::size_t count = 1;
+      return m_count.compare_exchange_strong(count, 0, std::memory_order_acquire, std::memory_order_relaxed);
+   }
+
+   std::size_t cs_get_ref_count(std::memory_order order = std::memory_order_seq_cst) const {
+      return m_count.load(order) & ~ImmortalFlag;
+   }
+
+   // an immortal object is never deleted, the flag is never cleared
+   void cs_freeze() const noexcept {
+      m_count.fetch_or(ImmortalFlag, std::memory_order_relaxed);
+   }
+
+   bool cs_is_immortal() const noexcept {
+      return (m_count.load(std::memory_order_relaxed) & ImmortalFlag) != 0;
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+
+   template <std::memory_order IncOrder, std::memory_order DecOrder>
+   friend class CsIntrusiveOrderPolicy;
+};
+
+class CsIntrusiveBase_CM
+{
+ public:
+   CsIntrusiveBase_CM() = default;
+
+   CsIntrusiveBase_CM(const CsIntrusiveBase_CM &other) noexcept {
+      m_count = 0;
+   }
+
+   CsIntrusiveBase_CM &operator=(const CsIntrusiveBase_CM &other) noexcept {
+      // copy assignment does not alter the reference count
+      return *this;
+   }
+
+   CsIntrusiveBase_CM(CsIntrusiveBase_CM &&other) noexcept {
+      m_count = 0;
+   }
+
+   CsIntrusiveBase_CM &operator=(CsIntrusiveBase_CM &&other) noexcept {
+      // move assignment does not alter the reference count
+      return *this;
+   }
+
+   virtual ~CsIntrusiveBase_CM() = default;
+
+ private:
+   static constexpr std::size_t ImmortalFlag = std::size_t(1) << (std::numeric_limits<std::size_t>::digits - 1);
+
    mutable std::atomic<std::size_t> m_count = 0;
 
-   void cs_inc_ref_count() const noexcept {
-      m_count.fetch_add(1);
+   void cs_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_count.fetch_add(1, order);
+   }
+
+   void cs_inc_ref_count(std::size_t n, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_count.fetch_add(n, order);
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      return cs_dec_ref_count(1, action, order);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      std::size_t old_count = m_count.fetch_sub(n, order);
+
+      if (old_count == n && (order == std::memory_order_release || order == std::memory_order_relaxed)) {
+         // pairs with the release decrement of every other owner
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
+      if (action != CsIntrusiveAction::NoDelete) {
+         if (old_count == n) {
+            delete this;
+         }
+      }
+
+      return old_count == n;
+   }
+
+   bool cs_try_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      std::size_t count = m_count.load(std::memory_order_relaxed);
+
+      do {
+         if (count == 0) {
+            return false;
+         }
+
+      } while (! m_count.compare_exchange_weak(count, count + 1, order, std::memory_order_relaxed));
+
+      return true;
+   }
+
+   // succeeds only if the caller holds the only reference, the count is left at zero
+   bool cs_try_take_unique() const noexcept {
+      std::size_t count = 1;
+      return m_count.compare_exchange_strong(count, 0, std::memory_order_acquire, std::memory_order_relaxed);
+   }
+
+   std::size_t cs_get_ref_count(std::memory_order order = std::memory_order_seq_cst) const {
+      return m_count.load(order) & ~ImmortalFlag;
+   }
+
+   // an immortal object is never deleted, the flag is never cleared
+   void cs_freeze() const noexcept {
+      m_count.fetch_or(ImmortalFlag, std::memory_order_relaxed);
+   }
+
+   bool cs_is_immortal() const noexcept {
+      return (m_count.load(std::memory_order_relaxed) & ImmortalFlag) != 0;
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+
+   template <std::memory_order IncOrder, std::memory_order DecOrder>
+   friend class CsIntrusiveOrderPolicy;
+};
+
+// the top bit of the count marks a frozen object, when the count reaches the largest value
+// below that bit Checked calls std::terminate() and Saturate pins the count, a pinned
+// count is immortal and the object is never deleted
+
+enum class CsIntrusiveOverflow {
+   Checked,
+   Saturate,
+};
+
+// deletes through the static type Derived so no virtual destructor is required,
+// the most derived type of every object must be Derived
+
+template <typename Derived, typename CountType = std::size_t, CsIntrusiveOverflow Overflow = CsIntrusiveOverflow::Checked>
+class CsIntrusiveBaseT
+{
+ public:
+   static_assert(std::is_unsigned_v<CountType>, "CountType must be an unsigned integer type");
+
+   CsIntrusiveBaseT() = default;
+
+   CsIntrusiveBaseT(const CsIntrusiveBaseT &) = delete;
+   CsIntrusiveBaseT &operator=(const CsIntrusiveBaseT &) = delete;
+
+ protected:
+   ~CsIntrusiveBaseT() = default;
+
+ private:
+   static constexpr CountType ImmortalFlag = CountType(1) << (std::numeric_limits<CountType>::digits - 1);
+   static constexpr CountType MaxCount     = ImmortalFlag - 1;
+
+   mutable std::atomic<CountType> m_count = 0;
+
+   void cs_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      cs_inc_ref_count(1, order);
+   }
+
+   void cs_inc_ref_count(std::size_t n, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      if constexpr (Overflow == CsIntrusiveOverflow::Saturate) {
+         CountType count = m_count.load(std::memory_order_relaxed);
+         CountType newCount;
+
+         do {
+            CountType value = count & MaxCount;
+
+            if (value == MaxCount) {
+               return;
+            }
+
+            value    = (n >= std::size_t(MaxCount - value)) ? MaxCount : CountType(value + n);
+            newCount = (count & ImmortalFlag) | value;
+
+         } while (! m_count.compare_exchange_weak(count, newCount, order, std::memory_order_relaxed));
+
+      } else {
+         if (n > MaxCount || (m_count.fetch_add(CountType(n), order) & MaxCount) > MaxCount - n) {
+            // count reached the immortal flag
+            std::terminate();
+         }
+      }
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      return cs_dec_ref_count(1, action, order);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      CountType old_count;
+
+      if constexpr (Overflow == CsIntrusiveOverflow::Saturate) {
+         old_count = m_count.load(std::memory_order_relaxed);
+
+         do {
+            if ((old_count & MaxCount) == MaxCount) {
+               return false;
+            }
+
+         } while (! m_count.compare_exchange_weak(old_count, CountType(old_count - n), order, std::memory_order_relaxed));
+
+      } else {
+         old_count = m_count.fetch_sub(CountType(n), order);
+      }
+
+      if (old_count == n && (order == std::memory_order_release || order == std::memory_order_relaxed)) {
+         // pairs with the release decrement of every other owner
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
+      if (action != CsIntrusiveAction::NoDelete) {
+         if (old_count == n) {
+            delete static_cast<const Derived *>(this);
+         }
+      }
+
+      return old_count == n;
+   }
+
+   bool cs_try_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      CountType count = m_count.load(std::memory_order_relaxed);
+
+      do {
+         if (count == 0) {
+            return false;
+         }
+
+         if ((count & MaxCount) == MaxCount) {
+            if constexpr (Overflow == CsIntrusiveOverflow::Saturate) {
+               return true;
+            } else {
+               std::terminate();
+            }
+         }
+
+      } while (! m_count.compare_exchange_weak(count, count + 1, order, std::memory_order_relaxed));
+
+      return true;
+   }
+
+   // succeeds only if the caller holds the only reference, the count is left at zero
+   bool cs_try_take_unique() const noexcept {
+      CountType count = 1;
+      return m_count.compare_exchange_strong(count, 0, std::memory_order_acquire, std::memory_order_relaxed);
+   }
+
+   std::size_t cs_get_ref_count(std::memory_order order = std::memory_order_seq_cst) const {
+      return m_count.load(order) & MaxCount;
+   }
+
+   // an immortal object is never deleted, the flag is never cleared
+   void cs_freeze() const noexcept {
+      m_count.fetch_or(ImmortalFlag, std::memory_order_relaxed);
+   }
+
+   bool cs_is_immortal() const noexcept {
+      CountType count = m_count.load(std::memory_order_relaxed);
+
+      if constexpr (Overflow == CsIntrusiveOverflow::Saturate) {
+         if ((count & MaxCount) == MaxCount) {
+            return true;
+         }
+      }
+
+      return (count & ImmortalFlag) != 0;
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+
+   template <std::memory_order IncOrder, std::memory_order DecOrder>
+   friend class CsIntrusiveOrderPolicy;
+};
+
+class CsIntrusiveBase_ST
+{
+ public:
+   CsIntrusiveBase_ST() = default;
+
+   // a copy would start with the reference count of the source object
+   CsIntrusiveBase_ST(const CsIntrusiveBase_ST &) = delete;
+   CsIntrusiveBase_ST &operator=(const CsIntrusiveBase_ST &) = delete;
+
+   virtual ~CsIntrusiveBase_ST() = default;
+
+ private:
+   mutable std::size_t m_count = 0;
+   CsIntrusiveThreadCheck m_check;
+
+   void cs_inc_ref_count(std::size_t n = 1) const noexcept {
+      m_check.check();
+      m_count += n;
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action) const {
+      return cs_dec_ref_count(1, action);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action) const {
+      m_check.check();
+
+      std::size_t old_count = m_count;
+      m_count -= n;
+
+      if (action != CsIntrusiveAction::NoDelete) {
+         if (old_count == n) {
+            delete this;
+         }
+      }
+
+      return old_count == n;
+   }
+
+   std::size_t cs_get_ref_count() const {
+      return m_count;
+   }
+
+   bool cs_try_take_unique() const noexcept {
+      m_check.check();
+
+      if (m_count != 1) {
+         return false;
+      }
+
+      m_count = 0;
+      return true;
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+   friend class CsIntrusiveSingleThreadPolicy;
+};
+
+class CsIntrusiveBase_ST_CM
+{
+ public:
+   CsIntrusiveBase_ST_CM() = default;
+
+   CsIntrusiveBase_ST_CM(const CsIntrusiveBase_ST_CM &) noexcept {
+      m_count = 0;
+   }
+
+   CsIntrusiveBase_ST_CM &operator=(const CsIntrusiveBase_ST_CM &) noexcept {
+      // copy assignment does not alter the reference count
+      return *this;
+   }
+
+   CsIntrusiveBase_ST_CM(CsIntrusiveBase_ST_CM &&) noexcept {
+      m_count = 0;
+   }
+
+   CsIntrusiveBase_ST_CM &operator=(CsIntrusiveBase_ST_CM &&) noexcept {
+      // move assignment does not alter the reference count
+      return *this;
+   }
+
+   virtual ~CsIntrusiveBase_ST_CM() = default;
+
+ private:
+   mutable std::size_t m_count = 0;
+   CsIntrusiveThreadCheck m_check;
+
+   void cs_inc_ref_count(std::size_t n = 1) const noexcept {
+      m_check.check();
+      m_count += n;
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action) const {
+      return cs_dec_ref_count(1, action);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action) const {
+      m_check.check();
+
+      std::size_t old_count = m_count;
+      m_count -= n;
+
+      if (action != CsIntrusiveAction::NoDelete) {
+         if (old_count == n) {
+            delete this;
+         }
+      }
+
+      return old_count == n;
+   }
+
+   std::size_t cs_get_ref_count() const {
+      return m_count;
+   }
+
+   bool cs_try_take_unique() const noexcept {
+      m_check.check();
+
+      if (m_count != 1) {
+         return false;
+      }
+
+      m_count = 0;
+      return true;
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+   friend class CsIntrusiveSingleThreadPolicy;
+};
+
+class CsIntrusiveDefaultPolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      ptr->cs_inc_ref_count();
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      return ptr->cs_dec_ref_count(action);
+   }
+
+   // adds or removes n references, one atomic operation when the base class supports it
+   template <typename T>
+   static void inc_ref_count(const T *ptr, std::size_t n) noexcept {
+      if constexpr (requires { ptr->cs_inc_ref_count(n); }) {
+         ptr->cs_inc_ref_count(n);
+
+      } else {
+         for (std::size_t i = 0; i < n; ++i) {
+            ptr->cs_inc_ref_count();
+         }
+      }
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, std::size_t n, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      if constexpr (requires { ptr->cs_dec_ref_count(n, action); }) {
+         return ptr->cs_dec_ref_count(n, action);
+
+      } else {
+         for (std::size_t i = 1; i < n; ++i) {
+            ptr->cs_dec_ref_count(CsIntrusiveAction::NoDelete);
+         }
+
+         return ptr->cs_dec_ref_count(action);
+      }
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return ptr->cs_get_ref_count();
+   }
+
+   // increments only if the object is still alive
+   template <typename T>
+      requires requires (const T *p) { p->cs_try_inc_ref_count(); }
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      return ptr->cs_try_inc_ref_count();
+   }
+
+   // succeeds only if ptr holds the only reference, the caller then owns the object
+   template <typename T>
+      requires requires (const T *p) { p->cs_try_take_unique(); }
+   static bool try_take_unique(const T *ptr) noexcept {
+      return ptr->cs_try_take_unique();
+   }
+
+   template <typename T>
+      requires requires (const T *p) { p->cs_freeze(); }
+   static void freeze(const T *ptr) noexcept {
+      ptr->cs_freeze();
+   }
+
+   template <typename T>
+   static bool is_immortal(const T *ptr) noexcept {
+      if constexpr (requires { ptr->cs_is_immortal(); }) {
+         return ptr->cs_is_immortal();
+      } else {
+         return false;
+      }
+   }
+};
+
+// increments are relaxed since a new owner can only be created from an existing one,
+// decrements use DecOrder and the final owner synchronizes before the object is deleted
+
+template <std::memory_order IncOrder, std::memory_order DecOrder>
+class CsIntrusiveOrderPolicy
+{
+ public:
+   static_assert(DecOrder == std::memory_order_release || DecOrder == std::memory_order_acq_rel
+         || DecOrder == std::memory_order_seq_cst, "DecOrder must be release, acq_rel, or seq_cst");
+
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      ptr->cs_inc_ref_count(IncOrder);
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      return ptr->cs_dec_ref_count(action, DecOrder);
+   }
+
+   template <typename T>
+   static void inc_ref_count(const T *ptr, std::size_t n) noexcept {
+      if constexpr (requires { ptr->cs_inc_ref_count(n, IncOrder); }) {
+         ptr->cs_inc_ref_count(n, IncOrder);
+
+      } else {
+         for (std::size_t i = 0; i < n; ++i) {
+            ptr->cs_inc_ref_count(IncOrder);
+         }
+      }
    }
 
-   void cs_dec_ref_count(CsIntrusiveAction action) const {
-      std::size_t old_count = m_count.fetch_sub(1);
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, std::size_t n, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      if constexpr (requires { ptr->cs_dec_ref_count(n, action, DecOrder); }) {
+         return ptr->cs_dec_ref_count(n, action, DecOrder);
 
-      if (action != CsIntrusiveAction::NoDelete) {
-         if (old_count == 1) {
-            delete this;
+      } else {
+         for (std::size_t i = 1; i < n; ++i) {
+            ptr->cs_dec_ref_count(CsIntrusiveAction::NoDelete, DecOrder);
          }
+
+         return ptr->cs_dec_ref_count(action, DecOrder);
       }
    }
 
-   std::size_t cs_get_ref_count() const {
-      return m_count.load();
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return ptr->cs_get_ref_count(std::memory_order_acquire);
    }
 
-   friend class CsIntrusiveDefaultPolicy;
+   template <typename T>
+      requires requires (const T *p) { p->cs_try_inc_ref_count(IncOrder); }
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      return ptr->cs_try_inc_ref_count(IncOrder);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { p->cs_try_take_unique(); }
+   static bool try_take_unique(const T *ptr) noexcept {
+      return ptr->cs_try_take_unique();
+   }
+
+   template <typename T>
+      requires requires (const T *p) { p->cs_freeze(); }
+   static void freeze(const T *ptr) noexcept {
+      ptr->cs_freeze();
+   }
+
+   template <typename T>
+   static bool is_immortal(const T *ptr) noexcept {
+      if constexpr (requires { ptr->cs_is_immortal(); }) {
+         return ptr->cs_is_immortal();
+      } else {
+         return false;
+      }
+   }
 };
 
-class CsIntrusiveBase_CM
+using CsIntrusiveRelaxedPolicy = CsIntrusiveOrderPolicy<std::memory_order_relaxed, std::memory_order_release>;
+using CsIntrusiveAcqRelPolicy  = CsIntrusiveOrderPolicy<std::memory_order_relaxed, std::memory_order_acq_rel>;
+
+// objects must inherit from CsIntrusiveBase_ST or CsIntrusiveBase_ST_CM and remain on one thread
+
+class CsIntrusiveSingleThreadPolicy
 {
  public:
-   CsIntrusiveBase_CM() = default;
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      static_assert(is_single_thread<T>(), "Class T must inherit from CsIntrusiveBase_ST or CsIntrusiveBase_ST_CM");
+      ptr->cs_inc_ref_count();
+   }
 
-   CsIntrusiveBase_CM(const CsIntrusiveBase_CM &other) noexcept {
-      m_count = 0;
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      static_assert(is_single_thread<T>(), "Class T must inherit from CsIntrusiveBase_ST or CsIntrusiveBase_ST_CM");
+      return ptr->cs_dec_ref_count(action);
    }
 
-   CsIntrusiveBase_CM &operator=(const CsIntrusiveBase_CM &other) noexcept {
-      // copy assignment does not alter the reference count
-      return *this;
+   template <typename T>
+   static void inc_ref_count(const T *ptr, std::size_t n) noexcept {
+      static_assert(is_single_thread<T>(), "Class T must inherit from CsIntrusiveBase_ST or CsIntrusiveBase_ST_CM");
+      ptr->cs_inc_ref_count(n);
    }
 
-   CsIntrusiveBase_CM(CsIntrusiveBase_CM &&other) noexcept {
-      m_count = 0;
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, std::size_t n, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      static_assert(is_single_thread<T>(), "Class T must inherit from CsIntrusiveBase_ST or CsIntrusiveBase_ST_CM");
+      return ptr->cs_dec_ref_count(n, action);
    }
 
-   CsIntrusiveBase_CM &operator=(CsIntrusiveBase_CM &&other) noexcept {
-      // move assignment does not alter the reference count
-      return *this;
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return ptr->cs_get_ref_count();
    }
 
-   virtual ~CsIntrusiveBase_CM() = default;
+   template <typename T>
+      requires requires (const T *p) { p->cs_try_take_unique(); }
+   static bool try_take_unique(const T *ptr) noexcept {
+      return ptr->cs_try_take_unique();
+   }
 
  private:
-   mutable std::atomic<std::size_t> m_count = 0;
-
-   void cs_inc_ref_count() const noexcept {
-      m_count.fetch_add(1);
+   template <typename T>
+   static constexpr bool is_single_thread() {
+      return std::is_base_of_v<CsIntrusiveBase_ST, T> || std::is_base_of_v<CsIntrusiveBase_ST_CM, T>;
    }
+};
 
-   void cs_dec_ref_count(CsIntrusiveAction action) const {
-      std::size_t old_count = m_count.fetch_sub(1);
+// skips every reference count write for objects which have been frozen, use for singletons
+// and published immutable objects which are shared by many threads
 
-      if (action != CsIntrusiveAction::NoDelete) {
-         if (old_count == 1) {
-            delete this;
-         }
+template <typename Policy = CsIntrusiveDefaultPolicy>
+class CsIntrusiveImmortalPolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      if (Policy::is_immortal(ptr)) {
+         return;
       }
+
+      Policy::inc_ref_count(ptr);
    }
 
-   std::size_t cs_get_ref_count() const {
-      return m_count.load();
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      if (Policy::is_immortal(ptr)) {
+         return false;
+      }
+
+      return Policy::dec_ref_count(ptr, action);
    }
 
-   friend class CsIntrusiveDefaultPolicy;
-};
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return Policy::get_ref_count(ptr);
+   }
 
-class CsIntrusiveDefaultPolicy
-{
- public:
    template <typename T>
-   static void inc_ref_count(const T *ptr) noexcept {
-      ptr->cs_inc_ref_count();
+      requires requires (const T *p) { Policy::try_inc_ref_count(p); }
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      if (Policy::is_immortal(ptr)) {
+         return true;
+      }
+
+      return Policy::try_inc_ref_count(ptr);
    }
 
    template <typename T>
-   static void dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
-      ptr->cs_dec_ref_count(action);
+      requires requires (const T *p) { Policy::try_take_unique(p); }
+   static bool try_take_unique(const T *ptr) noexcept {
+      return Policy::try_take_unique(ptr);
    }
 
    template <typename T>
-   static std::size_t get_ref_count(const T *ptr) noexcept {
-      return ptr->cs_get_ref_count();
+      requires requires (const T *p) { Policy::freeze(p); }
+   static void freeze(const T *ptr) noexcept {
+      Policy::freeze(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::is_immortal(p); }
+   static bool is_immortal(const T *ptr) noexcept {
+      return Policy::is_immortal(ptr);
+   }
+
+   // called by release_intrusive_range() for objects which reached zero
+   template <typename T>
+      requires requires (const T *p) { Policy::destroy(p); }
+   static void destroy(const T *ptr) {
+      Policy::destroy(ptr);
    }
 };
 
@@ -157,6 +832,12 @@ class CsIntrusivePointer
       }
    }
 
+   template <typename U>
+   CsIntrusivePointer(U *p, CsIntrusiveAdoptTag) noexcept
+      : m_ptr(p)
+   {
+   }
+
    ~CsIntrusivePointer()
    {
       if (m_ptr != nullptr) {
@@ -215,7 +896,7 @@ class CsIntrusivePointer
    }
 
    template <typename U>
-   CsIntrusivePointer(const CsIntrusivePointer<U> &p) noexcept
+   CsIntrusivePointer(const CsIntrusivePointer<U, Policy> &p) noexcept
       : m_ptr(p.m_ptr)
    {
       if (m_ptr != nullptr) {
@@ -224,20 +905,20 @@ class CsIntrusivePointer
    }
 
    template <typename U>
-   CsIntrusivePointer & operator=(const CsIntrusivePointer<U> &p) {
-      CsIntrusivePointer<T>(p).swap(*this);
+   CsIntrusivePointer & operator=(const CsIntrusivePointer<U, Policy> &p) {
+      CsIntrusivePointer(p).swap(*this);
       return *this;
    }
 
    template <typename U>
-   CsIntrusivePointer(CsIntrusivePointer<U> &&p) noexcept
+   CsIntrusivePointer(CsIntrusivePointer<U, Policy> &&p) noexcept
       : m_ptr(p.m_ptr)
    {
       p.m_ptr = nullptr;
    }
 
    template <typename U>
-   CsIntrusivePointer & operator=(CsIntrusivePointer<U> &&p) {
+   CsIntrusivePointer & operator=(CsIntrusivePointer<U, Policy> &&p) {
       if (m_ptr == p.m_ptr) {
          return *this;
       }
@@ -282,23 +963,49 @@ class CsIntrusivePointer
       return m_ptr;
    }
 
+   // returns the raw pointer and gives up ownership of the reference without decrementing the count
+   [[nodiscard]] Pointer detach() noexcept {
+      Pointer tmpPtr = m_ptr;
+      m_ptr = nullptr;
+
+      return tmpPtr;
+   }
+
    bool is_null() const noexcept {
       return m_ptr == nullptr;
    }
 
    Pointer release_if() noexcept {
-      if (use_count() == 1) {
-         Pointer tmpPtr = m_ptr;
-         Policy::dec_ref_count(m_ptr, CsIntrusiveAction::NoDelete);
+      if constexpr (requires { Policy::try_take_unique(m_ptr); }) {
+         return try_take_unique();
 
-         m_ptr = nullptr;
+      } else {
+         if (use_count() == 1) {
+            Pointer tmpPtr = m_ptr;
+            Policy::dec_ref_count(m_ptr, CsIntrusiveAction::NoDelete);
 
-         return tmpPtr;
+            m_ptr = nullptr;
 
-      } else {
-         return nullptr;
+            return tmpPtr;
+
+         } else {
+            return nullptr;
+
+         }
+      }
+   }
 
+   // if this is the only reference returns the raw pointer and releases ownership in one
+   // atomic step, otherwise returns nullptr and this pointer is unchanged
+   Pointer try_take_unique() noexcept {
+      if (m_ptr != nullptr && Policy::try_take_unique(m_ptr)) {
+         Pointer tmpPtr = m_ptr;
+         m_ptr = nullptr;
+
+         return tmpPtr;
       }
+
+      return nullptr;
    }
 
    void reset() {
@@ -311,7 +1018,12 @@ class CsIntrusivePointer
 
    template <typename U>
    void reset(U *p) {
-      CsIntrusivePointer<T>(p).swap(*this);
+      CsIntrusivePointer(p).swap(*this);
+   }
+
+   template <typename U>
+   void reset(U *p, CsIntrusiveAdoptTag tag) {
+      CsIntrusivePointer(p, tag).swap(*this);
    }
 
    void swap(CsIntrusivePointer &other) noexcept {
@@ -332,124 +1044,436 @@ class CsIntrusivePointer
 
    template <typename U, typename OtherPolicy>
    friend class CsIntrusivePointer;
+
+};
+
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy, typename... Args>
+CsIntrusivePointer<T, Policy> make_intrusive(Args &&... args)
+{
+   return CsIntrusivePointer<T, Policy>(new T(std::forward<Args>(args)...));
+}
+
+// object created by allocate_intrusive(), the destroying operator delete is selected by the virtual
+// destructor so every policy which deletes the object returns the memory to the allocator
+
+template <typename T, typename Alloc>
+class CsIntrusiveAllocated final : public T
+{
+ public:
+   template <typename... Args>
+   CsIntrusiveAllocated(const Alloc &alloc, Args &&... args)
+      : T(std::forward<Args>(args)...), m_alloc(alloc)
+   {
+   }
+
+   static void operator delete(CsIntrusiveAllocated *ptr, std::destroying_delete_t) {
+      using Traits = typename std::allocator_traits<Alloc>::template rebind_traits<CsIntrusiveAllocated>;
+
+      typename Traits::allocator_type alloc(ptr->m_alloc);
+      ptr->~CsIntrusiveAllocated();
+
+      Traits::deallocate(alloc, ptr, 1);
+   }
+
+ private:
+   [[no_unique_address]] Alloc m_alloc;
 };
 
-template <typename T, typename... Args>
-CsIntrusivePointer<T> make_intrusive(Args &&... args)
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy, typename Alloc, typename... Args>
+CsIntrusivePointer<T, Policy> allocate_intrusive(const Alloc &alloc, Args &&... args)
 {
-   return CsIntrusivePointer<T>(new T(std::forward<Args>(args)...));
+   static_assert(std::has_virtual_destructor_v<T>, "Class T must have a virtual destructor");
+   static_assert(! std::is_final_v<T>, "Class T can not be declared final");
+   static_assert(! requires { T::operator new(sizeof(T)); },
+         "Class T can not define operator new, allocate_intrusive() does not call it");
+
+   using Object = CsIntrusiveAllocated<T, Alloc>;
+   using Traits = typename std::allocator_traits<Alloc>::template rebind_traits<Object>;
+
+   typename Traits::allocator_type objAlloc(alloc);
+   Object *ptr = Traits::allocate(objAlloc, 1);
+
+   try {
+      ::new (static_cast<void *>(ptr)) Object(alloc, std::forward<Args>(args)...);
+
+   } catch (...) {
+      Traits::deallocate(objAlloc, ptr, 1);
+      throw;
+   }
+
+   return CsIntrusivePointer<T, Policy>(static_cast<T *>(ptr));
 }
 
 // equal
-template <typename T1, typename T2>
-bool operator==(const CsIntrusivePointer<T1> &ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename P1, typename T2, typename P2>
+bool operator==(const CsIntrusivePointer<T1, P1> &ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
    return ptr1.get() == ptr2.get();
 }
 
-template <typename T1, typename T2>
-bool operator==(const CsIntrusivePointer<T1> &ptr1, const T2 *ptr2) noexcept
+template <typename T1, typename P1, typename T2>
+bool operator==(const CsIntrusivePointer<T1, P1> &ptr1, const T2 *ptr2) noexcept
 {
     return ptr1.get() == ptr2;
 }
 
-template <typename T1, typename T2>
-bool operator==(const T1 *ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename T2, typename P2>
+bool operator==(const T1 *ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
     return ptr1 == ptr2.get();
 }
 
-template <typename T>
-bool operator==(const CsIntrusivePointer<T> &ptr1, std::nullptr_t) noexcept
+template <typename T, typename Policy>
+bool operator==(const CsIntrusivePointer<T, Policy> &ptr1, std::nullptr_t) noexcept
 {
    return ptr1.get() == nullptr;
 }
 
-template <typename T>
-bool operator==(std::nullptr_t, const CsIntrusivePointer<T> &ptr2) noexcept
+template <typename T, typename Policy>
+bool operator==(std::nullptr_t, const CsIntrusivePointer<T, Policy> &ptr2) noexcept
 {
    return nullptr == ptr2.get();
 }
 
 // not equal
-template <typename T1, typename T2>
-bool operator!=(const CsIntrusivePointer<T1> &ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename P1, typename T2, typename P2>
+bool operator!=(const CsIntrusivePointer<T1, P1> &ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
    return ptr1.get() != ptr2.get();
 }
 
-template <typename T1, typename T2>
-bool operator!=(const CsIntrusivePointer<T1> &ptr1, const T2 *ptr2) noexcept
+template <typename T1, typename P1, typename T2>
+bool operator!=(const CsIntrusivePointer<T1, P1> &ptr1, const T2 *ptr2) noexcept
 {
     return ptr1.get() != ptr2;
 }
 
-template <typename T1, typename T2>
-bool operator!=(const T1 *ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename T2, typename P2>
+bool operator!=(const T1 *ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
     return ptr1 != ptr2.get();
 }
 
-template <typename T>
-bool operator!=(const CsIntrusivePointer<T> &ptr1, std::nullptr_t) noexcept
+template <typename T, typename Policy>
+bool operator!=(const CsIntrusivePointer<T, Policy> &ptr1, std::nullptr_t) noexcept
 {
    return ptr1.get() != nullptr;
 }
 
-template <typename T>
-bool operator!=(std::nullptr_t, const CsIntrusivePointer<T> &ptr2) noexcept
+template <typename T, typename Policy>
+bool operator!=(std::nullptr_t, const CsIntrusivePointer<T, Policy> &ptr2) noexcept
 {
    return nullptr != ptr2.get();
 }
 
 // compare
-template <typename T1, typename T2>
-bool operator<(const CsIntrusivePointer<T1> &ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename P1, typename T2, typename P2>
+bool operator<(const CsIntrusivePointer<T1, P1> &ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
    return ptr1.get() < ptr2.get();
 }
 
-template <typename T1, typename T2>
-bool operator<=(const CsIntrusivePointer<T1> &ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename P1, typename T2, typename P2>
+bool operator<=(const CsIntrusivePointer<T1, P1> &ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
    return ptr1.get() <= ptr2.get();
 }
 
-template <typename T1, typename T2>
-bool operator>(const CsIntrusivePointer<T1> &ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename P1, typename T2, typename P2>
+bool operator>(const CsIntrusivePointer<T1, P1> &ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
    return ptr1.get() > ptr2.get();
 }
 
-template <typename T1, typename T2>
-bool operator>=(const CsIntrusivePointer<T1> &ptr1, const CsIntrusivePointer<T2> &ptr2) noexcept
+template <typename T1, typename P1, typename T2, typename P2>
+bool operator>=(const CsIntrusivePointer<T1, P1> &ptr1, const CsIntrusivePointer<T2, P2> &ptr2) noexcept
 {
    return ptr1.get() >= ptr2.get();
 }
 
-template <typename T>
-void swap(CsIntrusivePointer<T> &ptr1, CsIntrusivePointer<T> &ptr2) noexcept
+template <typename T, typename Policy>
+void swap(CsIntrusivePointer<T, Policy> &ptr1, CsIntrusivePointer<T, Policy> &ptr2) noexcept
 {
    ptr1.swap(ptr2);
 }
 
+template <typename T, typename Policy>
+struct cs_is_trivially_relocatable<CsIntrusivePointer<T, Policy>> : std::true_type {
+};
+
 // cast functions
-template <typename T, typename U>
-CsIntrusivePointer<T> const_pointer_cast(const CsIntrusivePointer<U> &ptr)
+template <typename T, typename U, typename Policy>
+CsIntrusivePointer<T, Policy> const_pointer_cast(const CsIntrusivePointer<U, Policy> &ptr)
+{
+   return CsIntrusivePointer<T, Policy>(const_cast<T *> (ptr.get()));
+}
+
+template <typename T, typename U, typename Policy>
+CsIntrusivePointer<T, Policy> dynamic_pointer_cast(const CsIntrusivePointer<U, Policy> &ptr)
+{
+   return CsIntrusivePointer<T, Policy>(dynamic_cast<T *> (ptr.get()));
+}
+
+template <typename T, typename U, typename Policy>
+CsIntrusivePointer<T, Policy> static_pointer_cast(const CsIntrusivePointer<U, Policy> &ptr)
+{
+   return CsIntrusivePointer<T, Policy>(static_cast<T *> (ptr.get()));
+}
+
+// rvalue casts transfer the reference held by ptr, the count is not modified
+template <typename T, typename U, typename Policy>
+CsIntrusivePointer<T, Policy> const_pointer_cast(CsIntrusivePointer<U, Policy> &&ptr) noexcept
+{
+   return CsIntrusivePointer<T, Policy>(const_cast<T *> (ptr.detach()), CsIntrusiveAdopt);
+}
+
+// ptr is not modified if the cast fails
+template <typename T, typename U, typename Policy>
+CsIntrusivePointer<T, Policy> dynamic_pointer_cast(CsIntrusivePointer<U, Policy> &&ptr) noexcept
+{
+   T *retval = dynamic_cast<T *> (ptr.get());
+
+   if (retval == nullptr) {
+      return CsIntrusivePointer<T, Policy>();
+   }
+
+   (void) ptr.detach();
+
+   return CsIntrusivePointer<T, Policy>(retval, CsIntrusiveAdopt);
+}
+
+template <typename T, typename U, typename Policy>
+CsIntrusivePointer<T, Policy> static_pointer_cast(CsIntrusivePointer<U, Policy> &&ptr) noexcept
+{
+   return CsIntrusivePointer<T, Policy>(static_cast<T *> (ptr.detach()), CsIntrusiveAdopt);
+}
+
+// caller must hold a reference, once frozen the object is never deleted
+template <typename T, typename Policy>
+void freeze(const CsIntrusivePointer<T, Policy> &ptr) noexcept
+{
+   if (ptr != nullptr) {
+      Policy::freeze(ptr.get());
+   }
+}
+
+template <typename T, typename Policy>
+bool is_immortal(const CsIntrusivePointer<T, Policy> &ptr) noexcept
+{
+   return ptr != nullptr && Policy::is_immortal(ptr.get());
+}
+
+// bulk operations, policies without a batched overload are called once per reference
+
+template <typename Policy, typename T>
+void cs_inc_ref_count_n(const T *ptr, std::size_t n)
+{
+   if constexpr (requires { Policy::inc_ref_count(ptr, n); }) {
+      Policy::inc_ref_count(ptr, n);
+
+   } else {
+      for (std::size_t i = 0; i < n; ++i) {
+         Policy::inc_ref_count(ptr);
+      }
+   }
+}
+
+template <typename Policy, typename T>
+void cs_dec_ref_count_n(const T *ptr, std::size_t n)
+{
+   if constexpr (requires { Policy::dec_ref_count(ptr, n); }) {
+      Policy::dec_ref_count(ptr, n);
+
+   } else {
+      for (std::size_t i = 0; i < n; ++i) {
+         Policy::dec_ref_count(ptr);
+      }
+   }
+}
+
+// groups references to recently seen objects, distinct objects beyond Size are flushed in turn
+
+template <typename T, typename Policy, bool Increment, std::size_t Size = 8>
+class CsIntrusiveCountBatch
+{
+ public:
+   CsIntrusiveCountBatch() = default;
+
+   CsIntrusiveCountBatch(const CsIntrusiveCountBatch &) = delete;
+   CsIntrusiveCountBatch &operator=(const CsIntrusiveCountBatch &) = delete;
+
+   ~CsIntrusiveCountBatch() {
+      flush();
+   }
+
+   void add(T *ptr) {
+      for (std::size_t i = 0; i < m_used; ++i) {
+         if (m_ptr[i] == ptr) {
+            ++m_count[i];
+            return;
+         }
+      }
+
+      if (m_used < Size) {
+         m_ptr[m_used]   = ptr;
+         m_count[m_used] = 1;
+         ++m_used;
+
+      } else {
+         apply(m_next);
+
+         m_ptr[m_next]   = ptr;
+         m_count[m_next] = 1;
+         m_next = (m_next + 1) % Size;
+      }
+   }
+
+   void flush() {
+      for (std::size_t i = 0; i < m_used; ++i) {
+         apply(i);
+      }
+
+      m_used = 0;
+      m_next = 0;
+   }
+
+ private:
+   void apply(std::size_t index) {
+      if constexpr (Increment) {
+         cs_inc_ref_count_n<Policy>(m_ptr[index], m_count[index]);
+      } else {
+         cs_dec_ref_count_n<Policy>(m_ptr[index], m_count[index]);
+      }
+   }
+
+   T *m_ptr[Size];
+   std::size_t m_count[Size];
+
+   std::size_t m_used = 0;
+   std::size_t m_next = 0;
+};
+
+template <typename T, typename Policy>
+std::vector<CsIntrusivePointer<T, Policy>> copy_intrusive(const std::vector<CsIntrusivePointer<T, Policy>> &list)
+{
+   std::vector<CsIntrusivePointer<T, Policy>> retval;
+   retval.reserve(list.size());
+
+   CsIntrusiveCountBatch<T, Policy, true> batch;
+
+   for (const auto &item : list) {
+      T *ptr = item.get();
+
+      if (ptr != nullptr) {
+         batch.add(ptr);
+      }
+
+      retval.emplace_back(ptr, CsIntrusiveAdopt);
+   }
+
+   batch.flush();
+
+   return retval;
+}
+
+template <typename T, typename Policy>
+void release_intrusive(std::vector<CsIntrusivePointer<T, Policy>> &list)
+{
+   CsIntrusiveCountBatch<T, Policy, false> batch;
+
+   for (auto &item : list) {
+      T *ptr = item.detach();
+
+      if (ptr != nullptr) {
+         batch.add(ptr);
+      }
+   }
+
+   list.clear();
+   batch.flush();
+}
+
+// prefetches the cache line at ptr for writing, the reference count of most intrusive bases
+// is stored in the first cache line of the object, the layouts in cs_intrusive_layout.h
+// move it elsewhere and only the object itself is prefetched
+
+template <typename T>
+void cs_prefetch_ref_count(const T *ptr) noexcept
 {
-   return CsIntrusivePointer<T>(const_cast<T *> (ptr.get()));
+#if defined(__GNUC__) || defined(__clang__)
+   __builtin_prefetch(ptr, 1, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+   _mm_prefetch(reinterpret_cast<const char *>(ptr), _MM_HINT_T0);
+#else
+   (void) ptr;
+#endif
 }
 
-template <typename T, typename U>
-CsIntrusivePointer<T> dynamic_pointer_cast(const CsIntrusivePointer<U> &ptr)
+// destroys an object whose count was released with CsIntrusiveAction::NoDelete, policies which
+// defer or queue deletion provide a static destroy()
+
+template <typename Policy, typename T>
+void cs_destroy_intrusive(const T *ptr)
 {
-   return CsIntrusivePointer<T>(dynamic_cast<T *> (ptr.get()));
+   if constexpr (requires { Policy::destroy(ptr); }) {
+      Policy::destroy(ptr);
+
+   } else {
+      delete ptr;
+   }
 }
 
-template <typename T, typename U>
-CsIntrusivePointer<T> static_pointer_cast(const CsIntrusivePointer<U> &ptr)
+inline constexpr std::size_t CsPrefetchDistance = 16;
+
+// releases every reference in [first, last), the target CsPrefetchDistance elements ahead is
+// prefetched before each decrement and objects which reach zero are destroyed once per block,
+// use for large ranges of distinct objects and release_intrusive() when targets repeat
+
+// policies whose dec_ref_count() does not report the last release are reset one at a time
+
+template <typename T, typename Policy>
+void release_intrusive_range(CsIntrusivePointer<T, Policy> *first, CsIntrusivePointer<T, Policy> *last)
 {
-   return CsIntrusivePointer<T>(static_cast<T *> (ptr.get()));
+   if constexpr (requires (const T *p) {
+         { Policy::dec_ref_count(p, CsIntrusiveAction::NoDelete) } -> std::convertible_to<bool>; }) {
+
+      constexpr std::ptrdiff_t BlockSize = 64;
+
+      T *deadList[BlockSize];
+
+      while (first != last) {
+         CsIntrusivePointer<T, Policy> *blockEnd = first + std::min(last - first, BlockSize);
+         std::ptrdiff_t deadCount = 0;
+
+         for (CsIntrusivePointer<T, Policy> *iter = first; iter != blockEnd; ++iter) {
+            if (last - iter > std::ptrdiff_t(CsPrefetchDistance)) {
+               cs_prefetch_ref_count(iter[CsPrefetchDistance].get());
+            }
+
+            T *ptr = iter->detach();
+
+            if (ptr != nullptr && Policy::dec_ref_count(ptr, CsIntrusiveAction::NoDelete)) {
+               deadList[deadCount] = ptr;
+               ++deadCount;
+            }
+         }
+
+         for (std::ptrdiff_t i = 0; i < deadCount; ++i) {
+            cs_destroy_intrusive<Policy>(deadList[i]);
+         }
+
+         first = blockEnd;
+      }
+
+   } else {
+      for (CsIntrusivePointer<T, Policy> *iter = first; iter != last; ++iter) {
+         if (last - iter > std::ptrdiff_t(CsPrefetchDistance)) {
+            cs_prefetch_ref_count(iter[CsPrefetchDistance].get());
+         }
+
+         iter->reset();
+      }
+   }
 }
 
 }   // end namespace
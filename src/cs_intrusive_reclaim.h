@@ -0,0 +1,404 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_RECLAIM_H
+#define LIB_CS_INTRUSIVE_RECLAIM_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CsPointer {
+
+// objects retired to a domain are destroyed once no hazard pointer refers to them and
+// every epoch guard which was active when they were retired has been released
+
+class CsReclaimDomain
+{
+ public:
+   using Deleter = void (*)(const void *);
+
+   struct Record {
+      std::atomic<const void *> m_hazard = nullptr;
+      std::atomic<std::uint64_t> m_epoch = 0;
+      std::atomic<bool> m_inUse = true;
+
+      Record *m_next = nullptr;
+   };
+
+   CsReclaimDomain() = default;
+
+   CsReclaimDomain(const CsReclaimDomain &) = delete;
+   CsReclaimDomain &operator=(const CsReclaimDomain &) = delete;
+
+   ~CsReclaimDomain() {
+      // no readers may be active when the domain is destroyed
+      Retired *node = m_retired.exchange(nullptr);
+
+      while (node != nullptr) {
+         Retired *next = node->m_next;
+
+         node->m_deleter(node->m_ptr);
+         delete node;
+
+         node = next;
+      }
+
+      Record *record = m_records.load();
+
+      while (record != nullptr) {
+         Record *next = record->m_next;
+         delete record;
+
+         record = next;
+      }
+   }
+
+   static CsReclaimDomain &global() {
+      static CsReclaimDomain domain;
+      return domain;
+   }
+
+   Record *acquire_record() {
+      for (Record *record = m_records.load(); record != nullptr; record = record->m_next) {
+         bool inUse = false;
+
+         if (record->m_inUse.compare_exchange_strong(inUse, true)) {
+            return record;
+         }
+      }
+
+      Record *record = new Record;
+      Record *head   = m_records.load();
+
+      do {
+         record->m_next = head;
+      } while (! m_records.compare_exchange_weak(head, record));
+
+      return record;
+   }
+
+   void release_record(Record *record) {
+      record->m_hazard.store(nullptr, std::memory_order_release);
+      record->m_epoch.store(0, std::memory_order_release);
+      record->m_inUse.store(false, std::memory_order_release);
+   }
+
+   // each thread keeps one record of the global domain checked out, so a reader does not
+   // search the shared list, nested readers and other domains use acquire_record()
+   Record *acquire_thread_record() {
+      if (this == &global()) {
+         ThreadRecord &cache = thread_record();
+
+         if (cache.m_record != nullptr) {
+            return std::exchange(cache.m_record, nullptr);
+         }
+      }
+
+      return acquire_record();
+   }
+
+   void release_thread_record(Record *record) {
+      if (this == &global()) {
+         ThreadRecord &cache = thread_record();
+
+         if (cache.m_record == nullptr) {
+            record->m_hazard.store(nullptr, std::memory_order_release);
+            record->m_epoch.store(0, std::memory_order_release);
+
+            cache.m_record = record;
+            return;
+         }
+      }
+
+      release_record(record);
+   }
+
+   std::uint64_t current_epoch() const {
+      return m_epoch.load();
+   }
+
+   void retire(const void *ptr, Deleter deleter) {
+      Retired *node = new Retired{ptr, deleter, m_epoch.load(), nullptr};
+      Retired *head = m_retired.load(std::memory_order_relaxed);
+
+      do {
+         node->m_next = head;
+      } while (! m_retired.compare_exchange_weak(head, node));
+
+      if (m_retiredCount.fetch_add(1, std::memory_order_relaxed) + 1 >= ReclaimThreshold) {
+         reclaim();
+      }
+   }
+
+   template <typename T>
+   void retire(const T *ptr) {
+      retire(ptr, [] (const void *p) { delete static_cast<const T *>(p); });
+   }
+
+   // destroys every retired object which can no longer be reached by a reader
+   void reclaim() {
+      try_advance_epoch();
+
+      Retired *node = m_retired.exchange(nullptr);
+
+      if (node == nullptr) {
+         return;
+      }
+
+      std::vector<const void *> hazards;
+
+      for (Record *record = m_records.load(); record != nullptr; record = record->m_next) {
+         const void *ptr = record->m_hazard.load();
+
+         if (ptr != nullptr) {
+            hazards.push_back(ptr);
+         }
+      }
+
+      std::sort(hazards.begin(), hazards.end());
+
+      std::uint64_t epoch = m_epoch.load();
+      Retired *keep = nullptr;
+
+      while (node != nullptr) {
+         Retired *next = node->m_next;
+
+         if (node->m_epoch + 2 <= epoch && ! std::binary_search(hazards.begin(), hazards.end(), node->m_ptr)) {
+            m_retiredCount.fetch_sub(1, std::memory_order_relaxed);
+
+            node->m_deleter(node->m_ptr);
+            delete node;
+
+         } else {
+            node->m_next = keep;
+            keep = node;
+         }
+
+         node = next;
+      }
+
+      while (keep != nullptr) {
+         Retired *next = keep->m_next;
+         Retired *head = m_retired.load(std::memory_order_relaxed);
+
+         do {
+            keep->m_next = head;
+         } while (! m_retired.compare_exchange_weak(head, keep));
+
+         keep = next;
+      }
+   }
+
+ private:
+   static constexpr std::size_t ReclaimThreshold = 64;
+
+   struct Retired {
+      const void *m_ptr;
+      Deleter m_deleter;
+      std::uint64_t m_epoch;
+
+      Retired *m_next;
+   };
+
+   struct ThreadRecord {
+      ~ThreadRecord() {
+         if (m_record != nullptr) {
+            global().release_record(m_record);
+         }
+      }
+
+      Record *m_record = nullptr;
+   };
+
+   static ThreadRecord &thread_record() {
+      thread_local ThreadRecord cache;
+      return cache;
+   }
+
+   void try_advance_epoch() {
+      std::uint64_t epoch = m_epoch.load();
+
+      for (Record *record = m_records.load(); record != nullptr; record = record->m_next) {
+         std::uint64_t readerEpoch = record->m_epoch.load();
+
+         if (readerEpoch != 0 && readerEpoch != epoch) {
+            // a reader is still in the previous epoch
+            return;
+         }
+      }
+
+      m_epoch.compare_exchange_strong(epoch, epoch + 1);
+   }
+
+   std::atomic<std::uint64_t> m_epoch = 1;
+   std::atomic<Record *> m_records    = nullptr;
+   std::atomic<Retired *> m_retired   = nullptr;
+   std::atomic<std::size_t> m_retiredCount = 0;
+};
+
+// protects a single pointer loaded from a shared location
+
+class CsHazardPointer
+{
+ public:
+   explicit CsHazardPointer(CsReclaimDomain &domain = CsReclaimDomain::global())
+      : m_domain(domain), m_record(domain.acquire_thread_record())
+   {
+   }
+
+   CsHazardPointer(const CsHazardPointer &) = delete;
+   CsHazardPointer &operator=(const CsHazardPointer &) = delete;
+
+   ~CsHazardPointer() {
+      m_domain.release_thread_record(m_record);
+   }
+
+   template <typename T>
+   T *protect(const std::atomic<T *> &src) {
+      T *ptr = src.load();
+
+      while (true) {
+         m_record->m_hazard.store(ptr);
+         T *verify = src.load();
+
+         if (verify == ptr) {
+            return ptr;
+         }
+
+         ptr = verify;
+      }
+   }
+
+   void reset() {
+      m_record->m_hazard.store(nullptr, std::memory_order_release);
+   }
+
+ private:
+   CsReclaimDomain &m_domain;
+   CsReclaimDomain::Record *m_record;
+};
+
+// protects every pointer loaded from a shared location while the guard is alive
+
+class CsEpochGuard
+{
+ public:
+   explicit CsEpochGuard(CsReclaimDomain &domain = CsReclaimDomain::global())
+      : m_domain(domain), m_record(domain.acquire_thread_record())
+   {
+      m_record->m_epoch.store(domain.current_epoch());
+   }
+
+   CsEpochGuard(const CsEpochGuard &) = delete;
+   CsEpochGuard &operator=(const CsEpochGuard &) = delete;
+
+   ~CsEpochGuard() {
+      m_domain.release_thread_record(m_record);
+   }
+
+   template <typename T>
+   T *protect(const std::atomic<T *> &src) const {
+      return src.load();
+   }
+
+ private:
+   CsReclaimDomain &m_domain;
+   CsReclaimDomain::Record *m_record;
+};
+
+// releasing the last reference retires the object to the global domain instead of deleting it
+
+template <typename Policy = CsIntrusiveDefaultPolicy>
+class CsIntrusiveReclaimPolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      Policy::inc_ref_count(ptr);
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      bool isLast = Policy::dec_ref_count(ptr, CsIntrusiveAction::NoDelete);
+
+      if (isLast && action != CsIntrusiveAction::NoDelete) {
+         CsReclaimDomain::global().retire(ptr);
+      }
+
+      return isLast;
+   }
+
+   // called by release_intrusive_range() for objects which reached zero
+   template <typename T>
+   static void destroy(const T *ptr) {
+      CsReclaimDomain::global().retire(ptr);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return Policy::get_ref_count(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::try_inc_ref_count(p); }
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      return Policy::try_inc_ref_count(ptr);
+   }
+
+   // a reader may still hold a hazard pointer to the object, ownership is never handed out
+   template <typename T>
+   static bool try_take_unique(const T *) noexcept {
+      return false;
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::freeze(p); }
+   static void freeze(const T *ptr) noexcept {
+      Policy::freeze(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::is_immortal(p); }
+   static bool is_immortal(const T *ptr) noexcept {
+      return Policy::is_immortal(ptr);
+   }
+};
+
+// true for policies which retire the last reference to a reclamation domain, a custom policy
+// with the same guarantee may specialize this to true
+
+template <typename Policy>
+struct cs_is_reclaim_policy : std::false_type {
+};
+
+template <typename Policy>
+struct cs_is_reclaim_policy<CsIntrusiveReclaimPolicy<Policy>> : std::true_type {
+};
+
+template <typename Policy>
+inline constexpr bool cs_is_reclaim_policy_v = cs_is_reclaim_policy<Policy>::value;
+
+}   // end namespace
+
+#endif
@@ -0,0 +1,127 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_REF_H
+#define LIB_CS_INTRUSIVE_REF_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <cassert>
+#include <cstddef>
+
+namespace CsPointer {
+
+// borrowed reference to an object owned elsewhere, passing it by value never modifies the
+// reference count, the caller must keep an owning pointer alive for the duration of the call
+
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy>
+class CsIntrusiveRef
+{
+ public:
+   using pointer      = T *;
+   using element_type = T;
+
+   using Pointer      = pointer;
+   using ElementType  = element_type;
+
+   constexpr CsIntrusiveRef() noexcept
+      : m_ptr(nullptr)
+   {
+   }
+
+   constexpr CsIntrusiveRef(std::nullptr_t) noexcept
+      : m_ptr(nullptr)
+   {
+   }
+
+   template <typename U>
+   explicit CsIntrusiveRef(U *p) noexcept
+      : m_ptr(p)
+   {
+   }
+
+   template <typename U>
+   CsIntrusiveRef(const CsIntrusivePointer<U, Policy> &p) noexcept
+      : m_ptr(p.get())
+   {
+   }
+
+   template <typename U>
+   CsIntrusiveRef(const CsIntrusiveRef<U, Policy> &p) noexcept
+      : m_ptr(p.get())
+   {
+   }
+
+   T &operator*() const noexcept {
+      check();
+      return *m_ptr;
+   }
+
+   T *operator->() const noexcept {
+      check();
+      return m_ptr;
+   }
+
+   bool operator !() const noexcept {
+      return m_ptr == nullptr;
+   }
+
+   explicit operator bool() const noexcept {
+      return m_ptr != nullptr;
+   }
+
+   T *get() const noexcept {
+      return m_ptr;
+   }
+
+   bool is_null() const noexcept {
+      return m_ptr == nullptr;
+   }
+
+   // increments the reference count
+   CsIntrusivePointer<T, Policy> toIntrusivePointer() const {
+      check();
+      return CsIntrusivePointer<T, Policy>(m_ptr);
+   }
+
+   template <typename U>
+   bool operator==(const CsIntrusiveRef<U, Policy> &p) const noexcept {
+      return m_ptr == p.get();
+   }
+
+   template <typename U>
+   bool operator==(const CsIntrusivePointer<U, Policy> &p) const noexcept {
+      return m_ptr == p.get();
+   }
+
+   bool operator==(std::nullptr_t) const noexcept {
+      return m_ptr == nullptr;
+   }
+
+ private:
+   void check() const noexcept {
+      assert((m_ptr == nullptr || Policy::get_ref_count(m_ptr) != 0) &&
+            "CsIntrusiveRef used after the object was released by its owners");
+   }
+
+   T *m_ptr;
+};
+
+}   // end namespace
+
+#endif
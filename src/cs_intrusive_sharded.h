@@ -0,0 +1,267 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_SHARDED_H
+#define LIB_CS_INTRUSIVE_SHARDED_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+namespace CsPointer {
+
+class CsIntrusiveShardedPolicy;
+
+// counts in m_count until sharding is enabled, afterwards each thread counts in one of the
+// shards and m_count holds one extra reference so it can not reach zero, collapsing folds
+// the shards back into m_count and releases the extra reference
+
+class CsIntrusiveBase_Sharded
+{
+ public:
+   static constexpr std::size_t ShardCount = 32;
+
+   CsIntrusiveBase_Sharded() = default;
+
+   CsIntrusiveBase_Sharded(const CsIntrusiveBase_Sharded &) = delete;
+   CsIntrusiveBase_Sharded &operator=(const CsIntrusiveBase_Sharded &) = delete;
+
+   virtual ~CsIntrusiveBase_Sharded() {
+      delete [] to_shards(m_shards.load(std::memory_order_relaxed));
+   }
+
+ private:
+   struct alignas(64) Shard {
+      std::atomic<std::int64_t> m_count = 0;
+   };
+
+   static constexpr std::int64_t DeadShard       = std::numeric_limits<std::int64_t>::min();
+   static constexpr std::uintptr_t CollapsedFlag = 1;
+
+   // keeps m_count above zero while shards with negative counts are folded
+   static constexpr std::size_t CollapseBias = std::size_t(1) << 62;
+
+   mutable std::atomic<std::size_t> m_count = 0;
+   mutable std::atomic<std::uintptr_t> m_shards = 0;
+
+   static Shard *to_shards(std::uintptr_t value) {
+      return reinterpret_cast<Shard *>(value & ~CollapsedFlag);
+   }
+
+   static bool is_sharded(std::uintptr_t value) {
+      return value != 0 && (value & CollapsedFlag) == 0;
+   }
+
+   static std::size_t shard_index() noexcept {
+      static std::atomic<std::size_t> nextIndex = 0;
+      thread_local std::size_t retval = nextIndex.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+
+      return retval;
+   }
+
+   // returns false if the shard has been folded into m_count
+   bool cs_shard_add(std::int64_t n) const noexcept {
+      std::uintptr_t value = m_shards.load(std::memory_order_acquire);
+
+      if (! is_sharded(value)) {
+         return false;
+      }
+
+      std::int64_t count = to_shards(value)[shard_index()].m_count.fetch_add(n, std::memory_order_acq_rel);
+
+      // a folded shard stays close to DeadShard, the change is ignored
+      return count > DeadShard / 2;
+   }
+
+   void cs_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      if (! cs_shard_add(1)) {
+         m_count.fetch_add(1, order);
+      }
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      if (cs_shard_add(-1)) {
+         // m_count holds the sharding reference
+         return false;
+      }
+
+      std::size_t oldCount = m_count.fetch_sub(1, order);
+
+      if (oldCount == 1 && (order == std::memory_order_release || order == std::memory_order_relaxed)) {
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
+      if (oldCount == 1 && action != CsIntrusiveAction::NoDelete) {
+         delete this;
+      }
+
+      return oldCount == 1;
+   }
+
+   bool cs_try_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      if (cs_shard_add(1)) {
+         return true;
+      }
+
+      std::size_t count = m_count.load(std::memory_order_relaxed);
+
+      do {
+         if (count == 0) {
+            return false;
+         }
+
+      } while (! m_count.compare_exchange_weak(count, count + 1, order, std::memory_order_relaxed));
+
+      return true;
+   }
+
+   bool cs_try_take_unique() const noexcept {
+      if (is_sharded(m_shards.load(std::memory_order_acquire))) {
+         return false;
+      }
+
+      std::size_t count = 1;
+      return m_count.compare_exchange_strong(count, 0, std::memory_order_acquire, std::memory_order_relaxed);
+   }
+
+   // approximate while sharded
+   std::size_t cs_get_ref_count(std::memory_order order = std::memory_order_seq_cst) const {
+      std::int64_t retval  = std::int64_t(m_count.load(order));
+      std::uintptr_t value = m_shards.load(std::memory_order_acquire);
+
+      if (is_sharded(value)) {
+         Shard *shards = to_shards(value);
+
+         for (std::size_t i = 0; i < ShardCount; ++i) {
+            std::int64_t count = shards[i].m_count.load(std::memory_order_relaxed);
+
+            if (count > DeadShard / 2) {
+               retval += count;
+            }
+         }
+
+         // sharding reference
+         --retval;
+      }
+
+      return retval < 0 ? 0 : std::size_t(retval);
+   }
+
+   // caller must hold a reference, sharding can be enabled once for each object
+   bool cs_enable_sharding() const {
+      if (m_shards.load(std::memory_order_acquire) != 0) {
+         return false;
+      }
+
+      Shard *shards = new Shard[ShardCount];
+      std::uintptr_t expected = 0;
+
+      m_count.fetch_add(1, std::memory_order_relaxed);
+
+      if (! m_shards.compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(shards),
+            std::memory_order_acq_rel)) {
+         // another thread enabled sharding first
+         m_count.fetch_sub(1, std::memory_order_relaxed);
+         delete [] shards;
+
+         return false;
+      }
+
+      return true;
+   }
+
+   // caller must hold a reference, after this call the object counts in m_count and
+   // releasing the last reference deletes the object
+   void cs_collapse() const {
+      // threads which observe the flag count in m_count before every shard is folded
+      m_count.fetch_add(CollapseBias, std::memory_order_relaxed);
+
+      std::uintptr_t value = m_shards.load(std::memory_order_acquire);
+
+      do {
+         if (! is_sharded(value)) {
+            m_count.fetch_sub(CollapseBias, std::memory_order_relaxed);
+            return;
+         }
+
+      } while (! m_shards.compare_exchange_weak(value, value | CollapsedFlag, std::memory_order_acq_rel));
+
+      Shard *shards = to_shards(value);
+
+      for (std::size_t i = 0; i < ShardCount; ++i) {
+         std::int64_t count = shards[i].m_count.exchange(DeadShard, std::memory_order_acq_rel);
+         m_count.fetch_add(std::size_t(count), std::memory_order_relaxed);
+      }
+
+      // remove the bias and the sharding reference, the caller still holds a reference
+      m_count.fetch_sub(CollapseBias + 1, std::memory_order_acq_rel);
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+   friend class CsIntrusiveShardedPolicy;
+
+   template <std::memory_order IncOrder, std::memory_order DecOrder>
+   friend class CsIntrusiveOrderPolicy;
+};
+
+class CsIntrusiveShardedPolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      ptr->cs_inc_ref_count(std::memory_order_relaxed);
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      return ptr->cs_dec_ref_count(action, std::memory_order_acq_rel);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return ptr->cs_get_ref_count();
+   }
+
+   template <typename T>
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      return ptr->cs_try_inc_ref_count();
+   }
+
+   template <typename T>
+   static bool try_take_unique(const T *ptr) noexcept {
+      return ptr->cs_try_take_unique();
+   }
+
+   // called by the thread which publishes a read mostly object
+   template <typename T>
+   static bool enable_sharding(const T *ptr) {
+      return ptr->cs_enable_sharding();
+   }
+
+   // called when the publisher begins releasing the object
+   template <typename T>
+   static void collapse(const T *ptr) {
+      ptr->cs_collapse();
+   }
+};
+
+}   // end namespace
+
+#endif
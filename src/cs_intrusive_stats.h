@@ -0,0 +1,357 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_STATS_H
+#define LIB_CS_INTRUSIVE_STATS_H
+
+#include <cs_intrusive_layout.h>
+#include <cs_intrusive_pointer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace CsPointer {
+
+// counters are written only by the owning thread with plain loads and stores,
+// snapshot() aggregates the counters of every thread which has used the type, the slot of a
+// finished thread keeps its counters and is handed to the next new thread
+
+class CsIntrusiveStats
+{
+ public:
+   // m_handoffCount is estimated from the sampled operations
+   struct TypeStats {
+      std::string m_name;
+
+      std::uint64_t m_incCount     = 0;
+      std::uint64_t m_decCount     = 0;
+      std::uint64_t m_handoffCount = 0;
+      std::uint64_t m_peakCount    = 0;
+   };
+
+   struct Slot {
+      std::atomic<std::uint64_t> m_incCount     = 0;
+      std::atomic<std::uint64_t> m_decCount     = 0;
+      std::atomic<std::uint64_t> m_handoffCount = 0;
+      std::atomic<std::uint64_t> m_peakCount    = 0;
+
+      // operations since the last handoff check, only used by the owning thread
+      std::uint32_t m_sampleCount = 0;
+
+      std::atomic<bool> m_inUse = true;
+      Slot *m_next = nullptr;
+   };
+
+   class Record
+   {
+    public:
+      explicit Record(const char *name)
+         : m_name(name)
+      {
+         Record *head = records().load(std::memory_order_relaxed);
+
+         do {
+            m_next = head;
+         } while (! records().compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+      }
+
+      Record(const Record &) = delete;
+      Record &operator=(const Record &) = delete;
+
+      // slots are never removed so counters survive the thread, a released slot is reused
+      // and its new owner continues counting from the previous totals
+      Slot *acquire_slot() {
+         for (Slot *slot = m_slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->m_next) {
+            bool inUse = false;
+
+            if (slot->m_inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+               return slot;
+            }
+         }
+
+         Slot *slot = new Slot;
+         Slot *head = m_slots.load(std::memory_order_relaxed);
+
+         do {
+            slot->m_next = head;
+         } while (! m_slots.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+
+         return slot;
+      }
+
+      std::size_t slot_count() const noexcept {
+         std::size_t retval = 0;
+
+         for (Slot *slot = m_slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->m_next) {
+            ++retval;
+         }
+
+         return retval;
+      }
+
+      // approximate, entries are shared by every object which hashes to the same index,
+      // each entry has its own cache line and is only written when its owner changes
+      bool is_handoff(const void *ptr) noexcept {
+         std::uintptr_t key   = reinterpret_cast<std::uintptr_t>(ptr) >> 4;
+         std::uint64_t owner  = (std::uint64_t(key) << 16) | (thread_index() & 0xFFFF);
+
+         std::atomic<std::uint64_t> &entry = m_owners[key % OwnerTableSize].m_owner;
+         std::uint64_t prevOwner = entry.load(std::memory_order_relaxed);
+
+         if (prevOwner == owner) {
+            return false;
+         }
+
+         entry.store(owner, std::memory_order_relaxed);
+
+         // same object, different thread
+         return (prevOwner >> 16) == (owner >> 16);
+      }
+
+    private:
+      static constexpr std::size_t OwnerTableSize = 128;
+
+      struct alignas(CsCacheLineSize) OwnerEntry {
+         std::atomic<std::uint64_t> m_owner = 0;
+      };
+
+      const char *m_name;
+      std::atomic<Slot *> m_slots = nullptr;
+      OwnerEntry m_owners[OwnerTableSize];
+
+      Record *m_next = nullptr;
+
+      friend class CsIntrusiveStats;
+   };
+
+   template <typename T>
+   static Record &record() {
+      static Record retval(cs_type_name<T>::name());
+      return retval;
+   }
+
+   // releases the slot when the thread exits
+   class SlotOwner
+   {
+    public:
+      explicit SlotOwner(Record &record)
+         : m_slot(record.acquire_slot())
+      {
+      }
+
+      SlotOwner(const SlotOwner &) = delete;
+      SlotOwner &operator=(const SlotOwner &) = delete;
+
+      ~SlotOwner()
+      {
+         m_slot->m_inUse.store(false, std::memory_order_release);
+      }
+
+      Slot *m_slot;
+   };
+
+   template <typename T>
+   static Slot &local_slot() {
+      thread_local SlotOwner owner(record<T>());
+      return *owner.m_slot;
+   }
+
+   static std::vector<TypeStats> snapshot() {
+      std::vector<TypeStats> retval;
+
+      for (Record *record = records().load(std::memory_order_acquire); record != nullptr; record = record->m_next) {
+         TypeStats stats;
+         stats.m_name = record->m_name;
+
+         for (Slot *slot = record->m_slots.load(std::memory_order_acquire); slot != nullptr; slot = slot->m_next) {
+            stats.m_incCount     += slot->m_incCount.load(std::memory_order_relaxed);
+            stats.m_decCount     += slot->m_decCount.load(std::memory_order_relaxed);
+            stats.m_handoffCount += slot->m_handoffCount.load(std::memory_order_relaxed);
+
+            stats.m_peakCount = std::max(stats.m_peakCount, slot->m_peakCount.load(std::memory_order_relaxed));
+         }
+
+         retval.push_back(std::move(stats));
+      }
+
+      return retval;
+   }
+
+   static std::string to_json(const std::vector<TypeStats> &list) {
+      std::ostringstream stream;
+      stream << "[";
+
+      for (std::size_t i = 0; i < list.size(); ++i) {
+         const TypeStats &stats = list[i];
+
+         stream << (i == 0 ? "" : ",") << "{\"type\":\"";
+
+         for (char c : stats.m_name) {
+            if (c == '"' || c == '\\') {
+               stream << '\\';
+            }
+
+            stream << c;
+         }
+
+         stream << "\",\"inc\":" << stats.m_incCount << ",\"dec\":" << stats.m_decCount
+                << ",\"handoff\":" << stats.m_handoffCount << ",\"peak\":" << stats.m_peakCount << "}";
+      }
+
+      stream << "]";
+
+      return stream.str();
+   }
+
+   static std::string to_text(const std::vector<TypeStats> &list) {
+      std::ostringstream stream;
+
+      for (const TypeStats &stats : list) {
+         stream << stats.m_name << "  inc = " << stats.m_incCount << "  dec = " << stats.m_decCount
+                << "  handoff = " << stats.m_handoffCount << "  peak = " << stats.m_peakCount << "\n";
+      }
+
+      return stream.str();
+   }
+
+ private:
+   static std::atomic<Record *> &records() {
+      static std::atomic<Record *> retval = nullptr;
+      return retval;
+   }
+
+   static std::uint32_t thread_index() noexcept {
+      static std::atomic<std::uint32_t> nextIndex = 0;
+      thread_local std::uint32_t retval = ++nextIndex;
+
+      return retval;
+   }
+};
+
+// records reference count traffic for each T and forwards every operation to Policy, every
+// HandoffSample operation of a thread is checked for a handoff and the result is scaled up,
+// a sample rate of 1 checks every operation and adds traffic to the shared owner table
+
+template <typename Policy = CsIntrusiveDefaultPolicy, std::uint32_t HandoffSample = 64>
+class CsIntrusiveStatsPolicy
+{
+ public:
+   static_assert(HandoffSample > 0, "HandoffSample must be at least 1");
+
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      Policy::inc_ref_count(ptr);
+      record_inc(ptr);
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      CsIntrusiveStats::Slot &slot = CsIntrusiveStats::local_slot<T>();
+      increment(slot.m_decCount);
+      sample_handoff(slot, ptr);
+
+      return Policy::dec_ref_count(ptr, action);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return Policy::get_ref_count(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::try_inc_ref_count(p); }
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      if (Policy::try_inc_ref_count(ptr)) {
+         record_inc(ptr);
+         return true;
+      }
+
+      return false;
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::try_take_unique(p); }
+   static bool try_take_unique(const T *ptr) noexcept {
+      if (Policy::try_take_unique(ptr)) {
+         increment(CsIntrusiveStats::local_slot<T>().m_decCount);
+         return true;
+      }
+
+      return false;
+   }
+
+   // called by release_intrusive_range() for objects which reached zero
+   template <typename T>
+      requires requires (const T *p) { Policy::destroy(p); }
+   static void destroy(const T *ptr) {
+      Policy::destroy(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::freeze(p); }
+   static void freeze(const T *ptr) noexcept {
+      Policy::freeze(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::is_immortal(p); }
+   static bool is_immortal(const T *ptr) noexcept {
+      return Policy::is_immortal(ptr);
+   }
+
+ private:
+   static void increment(std::atomic<std::uint64_t> &counter, std::uint64_t n = 1) noexcept {
+      counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+   }
+
+   template <typename T>
+   static void sample_handoff(CsIntrusiveStats::Slot &slot, const T *ptr) noexcept {
+      ++slot.m_sampleCount;
+
+      if (slot.m_sampleCount < HandoffSample) {
+         return;
+      }
+
+      slot.m_sampleCount = 0;
+
+      if (CsIntrusiveStats::record<T>().is_handoff(ptr)) {
+         increment(slot.m_handoffCount, HandoffSample);
+      }
+   }
+
+   template <typename T>
+   static void record_inc(const T *ptr) noexcept {
+      CsIntrusiveStats::Slot &slot = CsIntrusiveStats::local_slot<T>();
+      increment(slot.m_incCount);
+      sample_handoff(slot, ptr);
+
+      std::uint64_t count = Policy::get_ref_count(ptr);
+
+      if (count > slot.m_peakCount.load(std::memory_order_relaxed)) {
+         slot.m_peakCount.store(count, std::memory_order_relaxed);
+      }
+   }
+};
+
+}   // end namespace
+
+#endif
@@ -0,0 +1,135 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_TEARDOWN_H
+#define LIB_CS_INTRUSIVE_TEARDOWN_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <vector>
+
+namespace CsPointer {
+
+// objects released while another object on the same thread is being destroyed are added
+// to a worklist, the outermost release destroys the worklist so the stack depth is constant
+
+class CsTeardownList
+{
+ public:
+   using Deleter = void (*)(const void *);
+
+   static void destroy(const void *ptr, Deleter deleter) {
+      thread_local State state;
+
+      if (state.m_active) {
+         state.m_list.push_back({ptr, deleter});
+         return;
+      }
+
+      state.m_active = true;
+      deleter(ptr);
+
+      while (! state.m_list.empty()) {
+         Item item = state.m_list.back();
+         state.m_list.pop_back();
+
+         item.m_deleter(item.m_ptr);
+      }
+
+      state.m_active = false;
+   }
+
+   template <typename T>
+   static void destroy(const T *ptr) {
+      destroy(ptr, [] (const void *p) { delete static_cast<const T *>(p); });
+   }
+
+ private:
+   struct Item {
+      const void *m_ptr;
+      Deleter m_deleter;
+   };
+
+   struct State {
+      bool m_active = false;
+      std::vector<Item> m_list;
+   };
+};
+
+// releasing the last reference destroys the object through the teardown worklist,
+// use for linked chains and trees which are deeper than the stack allows
+
+template <typename Policy = CsIntrusiveDefaultPolicy>
+class CsIntrusiveIterativePolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      Policy::inc_ref_count(ptr);
+   }
+
+   template <typename T>
+   static bool dec_ref_count(const T *ptr, CsIntrusiveAction action = CsIntrusiveAction::Normal) {
+      bool isLast = Policy::dec_ref_count(ptr, CsIntrusiveAction::NoDelete);
+
+      if (isLast && action != CsIntrusiveAction::NoDelete) {
+         CsTeardownList::destroy(ptr);
+      }
+
+      return isLast;
+   }
+
+   // called by release_intrusive_range() for objects which reached zero
+   template <typename T>
+   static void destroy(const T *ptr) {
+      CsTeardownList::destroy(ptr);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return Policy::get_ref_count(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::try_inc_ref_count(p); }
+   static bool try_inc_ref_count(const T *ptr) noexcept {
+      return Policy::try_inc_ref_count(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::try_take_unique(p); }
+   static bool try_take_unique(const T *ptr) noexcept {
+      return Policy::try_take_unique(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::freeze(p); }
+   static void freeze(const T *ptr) noexcept {
+      Policy::freeze(ptr);
+   }
+
+   template <typename T>
+      requires requires (const T *p) { Policy::is_immortal(p); }
+   static bool is_immortal(const T *ptr) noexcept {
+      return Policy::is_immortal(ptr);
+   }
+};
+
+}   // end namespace
+
+#endif
@@ -0,0 +1,354 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_INTRUSIVE_WEAK_POINTER_H
+#define LIB_CS_INTRUSIVE_WEAK_POINTER_H
+
+#include <cs_intrusive_pointer.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace CsPointer {
+
+template <typename T, typename Policy>
+class CsIntrusiveWeakPointer;
+
+class CsIntrusiveBase_Weak;
+
+// allocated on first weak use, the object holds one weak reference until it is destroyed,
+// readers announce themselves before touching the object so the destructor of the object
+// can wait until no weak pointer is inside lock()
+
+class CsIntrusiveWeakBlock
+{
+ private:
+   explicit CsIntrusiveWeakBlock(const CsIntrusiveBase_Weak *object)
+      : m_object(object)
+   {
+   }
+
+   template <typename F>
+   auto visit(F func) const noexcept {
+      m_readers.fetch_add(1, std::memory_order_seq_cst);
+
+      auto retval = func(m_object.load(std::memory_order_seq_cst));
+
+      m_readers.fetch_sub(1, std::memory_order_release);
+
+      return retval;
+   }
+
+   // called by the destructor of the object
+   void expire() noexcept {
+      m_object.store(nullptr, std::memory_order_seq_cst);
+
+      while (m_readers.load(std::memory_order_seq_cst) != 0) {
+         std::this_thread::yield();
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+   }
+
+   void inc_weak() noexcept {
+      m_weak.fetch_add(1, std::memory_order_relaxed);
+   }
+
+   void dec_weak() noexcept {
+      if (m_weak.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+         delete this;
+      }
+   }
+
+   std::atomic<const CsIntrusiveBase_Weak *> m_object;
+   mutable std::atomic<std::size_t> m_readers = 0;
+   std::atomic<std::size_t> m_weak = 1;
+
+   friend class CsIntrusiveBase_Weak;
+
+   template <typename T, typename Policy>
+   friend class CsIntrusiveWeakPointer;
+};
+
+// the strong count is always stored in the object and updated with a single fetch_add or
+// fetch_sub, m_block is only set when the first weak pointer is created
+
+class CsIntrusiveBase_Weak
+{
+ public:
+   CsIntrusiveBase_Weak() = default;
+
+   CsIntrusiveBase_Weak(const CsIntrusiveBase_Weak &) = delete;
+   CsIntrusiveBase_Weak &operator=(const CsIntrusiveBase_Weak &) = delete;
+
+   virtual ~CsIntrusiveBase_Weak() {
+      CsIntrusiveWeakBlock *block = m_block.load(std::memory_order_acquire);
+
+      if (block != nullptr) {
+         block->expire();
+         block->dec_weak();
+      }
+   }
+
+ private:
+   mutable std::atomic<std::size_t> m_count = 0;
+   mutable std::atomic<CsIntrusiveWeakBlock *> m_block = nullptr;
+
+   void cs_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_count.fetch_add(1, order);
+   }
+
+   void cs_inc_ref_count(std::size_t n, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      m_count.fetch_add(n, order);
+   }
+
+   bool cs_dec_ref_count(CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      return cs_dec_ref_count(1, action, order);
+   }
+
+   bool cs_dec_ref_count(std::size_t n, CsIntrusiveAction action, std::memory_order order = std::memory_order_seq_cst) const {
+      std::size_t old_count = m_count.fetch_sub(n, order);
+
+      if (old_count == n && (order == std::memory_order_release || order == std::memory_order_relaxed)) {
+         // pairs with the release decrement of every other owner
+         std::atomic_thread_fence(std::memory_order_acquire);
+      }
+
+      if (old_count == n && action != CsIntrusiveAction::NoDelete) {
+         delete this;
+      }
+
+      return old_count == n;
+   }
+
+   bool cs_try_inc_ref_count(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+      std::size_t count = m_count.load(std::memory_order_relaxed);
+
+      do {
+         if (count == 0) {
+            return false;
+         }
+
+      } while (! m_count.compare_exchange_weak(count, count + 1, order, std::memory_order_relaxed));
+
+      return true;
+   }
+
+   // weak pointers expire when the caller takes unique ownership
+   bool cs_try_take_unique() const noexcept {
+      std::size_t count = 1;
+      return m_count.compare_exchange_strong(count, 0, std::memory_order_acquire, std::memory_order_relaxed);
+   }
+
+   std::size_t cs_get_ref_count(std::memory_order order = std::memory_order_seq_cst) const {
+      return m_count.load(order);
+   }
+
+   // caller must hold a strong reference
+   CsIntrusiveWeakBlock *cs_weak_block() const {
+      CsIntrusiveWeakBlock *block = m_block.load(std::memory_order_acquire);
+
+      if (block != nullptr) {
+         return block;
+      }
+
+      CsIntrusiveWeakBlock *newBlock = new CsIntrusiveWeakBlock(this);
+
+      if (! m_block.compare_exchange_strong(block, newBlock, std::memory_order_acq_rel, std::memory_order_acquire)) {
+         // another thread installed a block first
+         delete newBlock;
+         return block;
+      }
+
+      return newBlock;
+   }
+
+   friend class CsIntrusiveDefaultPolicy;
+
+   template <std::memory_order IncOrder, std::memory_order DecOrder>
+   friend class CsIntrusiveOrderPolicy;
+
+   template <typename T, typename Policy>
+   friend class CsIntrusiveWeakPointer;
+};
+
+template <typename T, typename Policy = CsIntrusiveDefaultPolicy>
+class CsIntrusiveWeakPointer
+{
+ public:
+   using pointer      = T *;
+   using element_type = T;
+
+   using Pointer      = pointer;
+   using ElementType  = element_type;
+
+   constexpr CsIntrusiveWeakPointer() noexcept
+      : m_block(nullptr)
+   {
+   }
+
+   constexpr CsIntrusiveWeakPointer(std::nullptr_t) noexcept
+      : m_block(nullptr)
+   {
+   }
+
+   template <typename U>
+   CsIntrusiveWeakPointer(const CsIntrusivePointer<U, Policy> &p)
+      : m_block(nullptr)
+   {
+      static_assert(std::is_convertible_v<U *, T *>, "Type U must be convertible to type T");
+
+      if (p != nullptr) {
+         m_block = p->cs_weak_block();
+         m_block->inc_weak();
+      }
+   }
+
+   ~CsIntrusiveWeakPointer()
+   {
+      if (m_block != nullptr) {
+         m_block->dec_weak();
+      }
+   }
+
+   CsIntrusiveWeakPointer(const CsIntrusiveWeakPointer &other) noexcept
+      : m_block(other.m_block)
+   {
+      if (m_block != nullptr) {
+         m_block->inc_weak();
+      }
+   }
+
+   CsIntrusiveWeakPointer &operator=(const CsIntrusiveWeakPointer &other) noexcept {
+      CsIntrusiveWeakPointer(other).swap(*this);
+      return *this;
+   }
+
+   CsIntrusiveWeakPointer(CsIntrusiveWeakPointer &&other) noexcept
+      : m_block(other.m_block)
+   {
+      other.m_block = nullptr;
+   }
+
+   CsIntrusiveWeakPointer &operator=(CsIntrusiveWeakPointer &&other) noexcept {
+      CsIntrusiveWeakPointer(std::move(other)).swap(*this);
+      return *this;
+   }
+
+   template <typename U>
+   CsIntrusiveWeakPointer &operator=(const CsIntrusivePointer<U, Policy> &p) {
+      CsIntrusiveWeakPointer(p).swap(*this);
+      return *this;
+   }
+
+   bool operator !() const noexcept {
+      return is_null();
+   }
+
+   explicit operator bool() const noexcept {
+      return ! is_null();
+   }
+
+   void clear() noexcept {
+      reset();
+   }
+
+   bool expired() const noexcept {
+      return use_count() == 0;
+   }
+
+   bool is_null() const noexcept {
+      return expired();
+   }
+
+   // lock free, returns an empty pointer if the object has been destroyed
+   CsIntrusivePointer<T, Policy> lock() const noexcept {
+      if (m_block == nullptr) {
+         return CsIntrusivePointer<T, Policy>();
+      }
+
+      const CsIntrusiveBase_Weak *object = m_block->visit([] (const CsIntrusiveBase_Weak *ptr) {
+         if (ptr != nullptr && ptr->cs_try_inc_ref_count(std::memory_order_acquire)) {
+            return ptr;
+         }
+
+         return static_cast<const CsIntrusiveBase_Weak *>(nullptr);
+      });
+
+      if (object == nullptr) {
+         return CsIntrusivePointer<T, Policy>();
+      }
+
+      return CsIntrusivePointer<T, Policy>(static_cast<T *>(const_cast<CsIntrusiveBase_Weak *>(object)), CsIntrusiveAdopt);
+   }
+
+   CsIntrusivePointer<T, Policy> toStrongRef() const noexcept {
+      return lock();
+   }
+
+   void reset() noexcept {
+      if (m_block != nullptr) {
+         m_block->dec_weak();
+         m_block = nullptr;
+      }
+   }
+
+   void swap(CsIntrusiveWeakPointer &other) noexcept {
+      std::swap(m_block, other.m_block);
+   }
+
+   std::size_t use_count() const noexcept {
+      if (m_block == nullptr) {
+         return 0;
+      }
+
+      return m_block->visit([] (const CsIntrusiveBase_Weak *ptr) {
+         return ptr == nullptr ? std::size_t(0) : ptr->cs_get_ref_count(std::memory_order_acquire);
+      });
+   }
+
+   template <typename U>
+   bool operator==(const CsIntrusiveWeakPointer<U, Policy> &ptr) const noexcept {
+      return m_block == ptr.m_block;
+   }
+
+   bool operator==(std::nullptr_t) const noexcept {
+      return expired();
+   }
+
+ private:
+   CsIntrusiveWeakBlock *m_block;
+
+   template <typename U, typename OtherPolicy>
+   friend class CsIntrusiveWeakPointer;
+};
+
+template <typename T, typename Policy>
+void swap(CsIntrusiveWeakPointer<T, Policy> &ptr1, CsIntrusiveWeakPointer<T, Policy> &ptr2) noexcept
+{
+   ptr1.swap(ptr2);
+}
+
+template <typename T, typename Policy>
+struct cs_is_trivially_relocatable<CsIntrusiveWeakPointer<T, Policy>> : std::true_type {
+};
+
+}   // end namespace
+
+#endif
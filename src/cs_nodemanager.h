@@ -22,6 +22,7 @@
 #include <cs_intrusive_pointer.h>
 
 #include <algorithm>
+#include <iterator>
 #include <vector>
 
 namespace CsPointer {
@@ -75,6 +76,41 @@ class CsNodeManager
 
       std::vector<CsIntrusivePointer<T, Policy>> tmp;
       swap(m_children, tmp);
+
+      if constexpr (std::is_base_of_v<CsNodeManager, T>) {
+         // children are released from a per thread worklist, a child destroyed by the policy
+         // runs ~T first and then adds its own children to the worklist from ~CsNodeManager,
+         // the stack depth does not depend on the depth of the tree
+         thread_local TeardownState state;
+
+         state.m_list.insert(state.m_list.end(), std::make_move_iterator(tmp.rbegin()),
+               std::make_move_iterator(tmp.rend()));
+
+         if (state.m_active) {
+            // released by the outermost clear() on this thread
+            return;
+         }
+
+         state.m_active = true;
+
+         while (! state.m_list.empty()) {
+            std::vector<CsIntrusivePointer<T, Policy>> &list = state.m_list;
+
+            if (list.size() > CsPrefetchDistance) {
+               cs_prefetch_ref_count(list[list.size() - 1 - CsPrefetchDistance].get());
+            }
+
+            CsIntrusivePointer<T, Policy> child = std::move(list.back());
+            list.pop_back();
+
+            child.reset();
+         }
+
+         state.m_active = false;
+
+      } else {
+         release_intrusive_range(tmp.data(), tmp.data() + tmp.size());
+      }
    }
 
    template <typename U>
@@ -89,20 +125,9 @@ class CsNodeManager
    template <typename U, typename F>
    std::vector<CsIntrusivePointer<U, Policy>> find_children(const F &lambda) const;
 
+   // intrusive pointers are trivially relocatable, the children in between are shifted with memmove
    void move_child(size_type source, size_type dest) {
-
-      if (source == dest) {
-         // do nothing
-
-      } else if (source < dest) {
-         std::rotate(m_children.begin() + source, m_children.begin() + source + 1,
-               m_children.begin() + dest + 1);
-
-      } else {
-         std::rotate(m_children.rend() - source - 1, m_children.rend() - source,
-               m_children.rend() - dest);
-      }
-
+      cs_relocate_element(m_children.data(), source, dest);
    }
 
    bool remove_child(T *child) {
@@ -125,6 +150,11 @@ class CsNodeManager
    VisitStatus visit(const F &lambda, VisitChildren option = VisitChildren::Recursive) const;
 
  private:
+   struct TeardownState {
+      bool m_active = false;
+      std::vector<CsIntrusivePointer<T, Policy>> m_list;
+   };
+
    std::vector<CsIntrusivePointer<T, Policy>> m_children;
 };
 
@@ -0,0 +1,293 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_OBJECT_REGISTRY_H
+#define LIB_CS_OBJECT_REGISTRY_H
+
+#include <cs_pointer_traits.h>
+#include <cs_shared_pointer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define CS_OBJECT_REGISTRY_BACKTRACE
+#endif
+
+namespace CsPointer {
+
+// tracking is opt-in, objects are spread over independently locked shards by address so
+// threads allocating different objects rarely contend on the same lock
+
+class CsObjectRegistry
+{
+ public:
+   struct Entry {
+      const void *m_ptr;
+      const char *m_typeName;
+      std::uint64_t m_sequence;
+
+      std::vector<void *> m_backtrace;
+   };
+
+   class Snapshot
+   {
+    public:
+      Snapshot() = default;
+
+      const std::vector<Entry> &entries() const {
+         return m_entries;
+      }
+
+      std::size_t count() const {
+         return m_entries.size();
+      }
+
+      std::map<std::string, std::size_t> count_by_type() const {
+         std::map<std::string, std::size_t> retval;
+
+         for (const Entry &entry : m_entries) {
+            ++retval[entry.m_typeName];
+         }
+
+         return retval;
+      }
+
+      // objects in this snapshot which were not alive when the earlier snapshot was taken
+      Snapshot diff(const Snapshot &before) const {
+         Snapshot retval;
+
+         std::set_difference(m_entries.begin(), m_entries.end(), before.m_entries.begin(), before.m_entries.end(),
+               std::back_inserter(retval.m_entries),
+               [] (const Entry &a, const Entry &b) { return a.m_sequence < b.m_sequence; });
+
+         return retval;
+      }
+
+      std::string to_text() const {
+         std::ostringstream stream;
+
+         for (const auto &item : count_by_type()) {
+            stream << item.first << "  live = " << item.second << "\n";
+         }
+
+         for (const Entry &entry : m_entries) {
+            if (entry.m_backtrace.empty()) {
+               continue;
+            }
+
+            stream << "\n#" << entry.m_sequence << "  " << entry.m_typeName << "  " << entry.m_ptr << "\n";
+
+#if defined(CS_OBJECT_REGISTRY_BACKTRACE)
+            char **symbols = backtrace_symbols(entry.m_backtrace.data(), int(entry.m_backtrace.size()));
+
+            for (std::size_t i = 0; i < entry.m_backtrace.size(); ++i) {
+               stream << "   " << (symbols != nullptr ? symbols[i] : "?") << "\n";
+            }
+
+            std::free(symbols);
+#endif
+         }
+
+         return stream.str();
+      }
+
+    private:
+      // sorted by sequence number
+      std::vector<Entry> m_entries;
+
+      friend class CsObjectRegistry;
+   };
+
+   static void set_enabled(bool enabled) noexcept {
+      s_enabled().store(enabled, std::memory_order_relaxed);
+   }
+
+   static bool is_enabled() noexcept {
+      return s_enabled().load(std::memory_order_relaxed);
+   }
+
+   // captures a backtrace for every nth registered object, zero disables capturing
+   static void set_backtrace_sampling(std::size_t interval) noexcept {
+      s_sampling().store(interval, std::memory_order_relaxed);
+   }
+
+   static constexpr bool has_backtrace() noexcept {
+#if defined(CS_OBJECT_REGISTRY_BACKTRACE)
+      return true;
+#else
+      return false;
+#endif
+   }
+
+   static std::uint64_t add(const void *ptr, const char *typeName) {
+      static std::atomic<std::uint64_t> nextSequence = 0;
+
+      Entry entry{ptr, typeName, nextSequence.fetch_add(1, std::memory_order_relaxed) + 1, {}};
+
+      std::size_t interval = s_sampling().load(std::memory_order_relaxed);
+
+      if (interval != 0) {
+         thread_local std::size_t sampleCount = 0;
+
+         if (++sampleCount >= interval) {
+            sampleCount = 0;
+            capture_backtrace(entry.m_backtrace);
+         }
+      }
+
+      std::uint64_t retval = entry.m_sequence;
+
+      Shard &shard = shard_for(ptr);
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      shard.m_live.insert_or_assign(ptr, std::move(entry));
+
+      return retval;
+   }
+
+   // removing an address which was never added is ignored, called from destructors where
+   // a std::system_error from locking the shard would terminate the program
+   static void remove(const void *ptr) {
+      Shard &shard = shard_for(ptr);
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      shard.m_live.erase(ptr);
+   }
+
+   static Snapshot snapshot() {
+      Snapshot retval;
+
+      for (Shard &shard : shards()) {
+         std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+         for (const auto &item : shard.m_live) {
+            retval.m_entries.push_back(item.second);
+         }
+      }
+
+      std::sort(retval.m_entries.begin(), retval.m_entries.end(),
+            [] (const Entry &a, const Entry &b) { return a.m_sequence < b.m_sequence; });
+
+      return retval;
+   }
+
+ private:
+   static constexpr std::size_t ShardCount     = 32;
+   static constexpr std::size_t BacktraceDepth = 32;
+
+   struct alignas(64) Shard {
+      std::mutex m_mutex;
+      std::unordered_map<const void *, Entry> m_live;
+   };
+
+   static std::atomic<bool> &s_enabled() {
+      static std::atomic<bool> retval = false;
+      return retval;
+   }
+
+   static std::atomic<std::size_t> &s_sampling() {
+      static std::atomic<std::size_t> retval = 0;
+      return retval;
+   }
+
+   static Shard (&shards())[ShardCount] {
+      static Shard retval[ShardCount];
+      return retval;
+   }
+
+   static Shard &shard_for(const void *ptr) noexcept {
+      std::uintptr_t key = reinterpret_cast<std::uintptr_t>(ptr) >> 4;
+      return shards()[(key ^ (key >> 7)) % ShardCount];
+   }
+
+   static void capture_backtrace([[maybe_unused]] std::vector<void *> &frames) {
+#if defined(CS_OBJECT_REGISTRY_BACKTRACE)
+      frames.resize(BacktraceDepth);
+      frames.resize(std::size_t(backtrace(frames.data(), int(BacktraceDepth))));
+#endif
+   }
+};
+
+// registers each object of type T while tracking is enabled, usable as a base class of
+// objects owned by either CsIntrusivePointer or CsSharedPointer
+
+template <typename T>
+class CsTrackedObject
+{
+ protected:
+   CsTrackedObject() {
+      track();
+   }
+
+   CsTrackedObject(const CsTrackedObject &) {
+      track();
+   }
+
+   CsTrackedObject &operator=(const CsTrackedObject &) {
+      return *this;
+   }
+
+   ~CsTrackedObject() {
+      if (m_tracked) {
+         CsObjectRegistry::remove(this);
+      }
+   }
+
+ private:
+   void track() {
+      if (CsObjectRegistry::is_enabled()) {
+         CsObjectRegistry::add(this, cs_type_name<T>::name());
+         m_tracked = true;
+      }
+   }
+
+   bool m_tracked = false;
+};
+
+// registers objects of a type which does not derive from CsTrackedObject, the object
+// and the control block are allocated separately while tracking is enabled
+
+template <typename T, typename... Args, typename = typename std::enable_if_t<! std::is_array_v<T>>>
+CsSharedPointer<T> make_tracked_shared(Args &&... args)
+{
+   if (! CsObjectRegistry::is_enabled()) {
+      return make_shared<T>(std::forward<Args>(args)...);
+   }
+
+   CsSharedPointer<T> retval(new T(std::forward<Args>(args)...), [] (T *ptr) {
+      CsObjectRegistry::remove(ptr);
+      delete ptr;
+   });
+
+   CsObjectRegistry::add(retval.get(), cs_type_name<T>::name());
+
+   return retval;
+}
+
+}   // end namespace
+
+#endif
@@ -19,6 +19,14 @@
 #ifndef LIB_CS_POINTER_TRAITS_H
 #define LIB_CS_POINTER_TRAITS_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
 namespace CsPointer {
 
 template <typename T>
@@ -34,6 +42,93 @@ struct cs_add_missing_extent<T[]> {
 template <typename T>
 using cs_add_missing_extent_t = typename cs_add_missing_extent<T>::type;
 
+// name reported for T by the statistics and the object registry, specialize to supply a
+// readable name, without RTTI the compiler generated signature of this function is used
+// since it contains T
+
+template <typename T>
+struct cs_type_name {
+   static const char *name() {
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+      return typeid(T).name();
+#elif defined(_MSC_VER)
+      return __FUNCSIG__;
+#else
+      return __PRETTY_FUNCTION__;
+#endif
+   }
+};
+
+// moving an object of a trivially relocatable type and destroying the source is equivalent
+// to copying its bytes, each pointer type is specialized to true
+
+template <typename T>
+struct cs_is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {
+};
+
+template <typename T>
+inline constexpr bool cs_is_trivially_relocatable_v = cs_is_trivially_relocatable<T>::value;
+
+// moves count objects to uninitialized storage at dest and ends the lifetime of the source
+// objects, the two ranges may overlap
+template <typename T>
+void cs_relocate(T *source, std::size_t count, T *dest) noexcept(cs_is_trivially_relocatable_v<T> ||
+      std::is_nothrow_move_constructible_v<T>)
+{
+   if (source == dest || count == 0) {
+      return;
+   }
+
+   if constexpr (cs_is_trivially_relocatable_v<T>) {
+      std::memmove(static_cast<void *>(dest), static_cast<const void *>(source), count * sizeof(T));
+
+   } else if (dest < source) {
+      for (std::size_t i = 0; i < count; ++i) {
+         ::new (static_cast<void *>(dest + i)) T(std::move(source[i]));
+         source[i].~T();
+      }
+
+   } else {
+      for (std::size_t i = count; i > 0; --i) {
+         ::new (static_cast<void *>(dest + i - 1)) T(std::move(source[i - 1]));
+         source[i - 1].~T();
+      }
+   }
+}
+
+// moves the element at index source to index dest, shifting the elements in between
+template <typename T>
+void cs_relocate_element(T *data, std::size_t source, std::size_t dest)
+{
+   if (source == dest) {
+      return;
+   }
+
+   if constexpr (cs_is_trivially_relocatable_v<T>) {
+      alignas(T) unsigned char tmp[sizeof(T)];
+      std::memcpy(tmp, static_cast<const void *>(data + source), sizeof(T));
+
+      if (source < dest) {
+         cs_relocate(data + source + 1, dest - source, data + source);
+      } else {
+         cs_relocate(data + dest, source - dest, data + dest + 1);
+      }
+
+      std::memcpy(static_cast<void *>(data + dest), tmp, sizeof(T));
+
+   } else {
+      T tmp = std::move(data[source]);
+
+      if (source < dest) {
+         std::move(data + source + 1, data + dest + 1, data + source);
+      } else {
+         std::move_backward(data + dest, data + source, data + source + 1);
+      }
+
+      data[dest] = std::move(tmp);
+   }
+}
+
 }   // end namespace
 
 #endif
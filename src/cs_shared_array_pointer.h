@@ -101,6 +101,10 @@ CsSharedArrayPointer<T> make_shared(std::size_t size)
    return std::shared_ptr<T>(new Type[size]);
 }
 
+template <typename T>
+struct cs_is_trivially_relocatable<CsSharedArrayPointer<T>> : std::true_type {
+};
+
 }   // end namespace
 
 #endif
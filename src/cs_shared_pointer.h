@@ -19,6 +19,8 @@
 #ifndef LIB_CS_SHARED_POINTER_H
 #define LIB_CS_SHARED_POINTER_H
 
+#include <cs_pointer_traits.h>
+
 #include <compare>
 #include <memory>
 
@@ -318,41 +320,62 @@ void swap(CsSharedPointer<T> &ptr1, CsSharedPointer<T> &ptr2) noexcept
    ptr1.swap(ptr2);
 }
 
-// cast functions
+template <typename T>
+struct cs_is_trivially_relocatable<CsSharedPointer<T>> : std::true_type {
+};
+
+// cast functions, the result shares ownership with ptr through the aliasing constructor
 template <typename T, typename U>
-CsSharedPointer<T> static_pointer_cast(const CsSharedPointer<U> &ptr)
+CsSharedPointer<T> static_pointer_cast(const CsSharedPointer<U> &ptr) noexcept
 {
-   return std::static_pointer_cast<T> (std::shared_ptr<U>(ptr));
+   return CsSharedPointer<T>(ptr, static_cast<T *> (ptr.get()));
 }
 
+// an empty pointer is returned without modifying the count if the cast fails
 template <typename T, typename U>
-CsSharedPointer<T> dynamic_pointer_cast(const CsSharedPointer<U> &ptr)
+CsSharedPointer<T> dynamic_pointer_cast(const CsSharedPointer<U> &ptr) noexcept
 {
-   return std::dynamic_pointer_cast<T> (std::shared_ptr<U>(ptr));
+   T *retval = dynamic_cast<T *> (ptr.get());
+
+   if (retval == nullptr) {
+      return CsSharedPointer<T>();
+   }
+
+   return CsSharedPointer<T>(ptr, retval);
 }
 
 template <typename T, typename U>
-CsSharedPointer<T> const_pointer_cast(const CsSharedPointer<U> &ptr)
+CsSharedPointer<T> const_pointer_cast(const CsSharedPointer<U> &ptr) noexcept
 {
-   return std::const_pointer_cast<T> (std::shared_ptr<U>(ptr));
+   return CsSharedPointer<T>(ptr, const_cast<T *> (ptr.get()));
 }
 
+// rvalue casts transfer ownership from ptr, the count is not modified
 template <typename T, typename U>
-CsSharedPointer<T> static_pointer_cast(CsSharedPointer<U> &&ptr)
+CsSharedPointer<T> static_pointer_cast(CsSharedPointer<U> &&ptr) noexcept
 {
-   return std::static_pointer_cast<T> (std::shared_ptr<U>(std::move(ptr)));
+   T *retval = static_cast<T *> (ptr.get());
+   return CsSharedPointer<T>(std::move(ptr), retval);
 }
 
+// ptr is not modified if the cast fails
 template <typename T, typename U>
-CsSharedPointer<T> dynamic_pointer_cast(CsSharedPointer<U> &&ptr)
+CsSharedPointer<T> dynamic_pointer_cast(CsSharedPointer<U> &&ptr) noexcept
 {
-   return std::dynamic_pointer_cast<T> (std::shared_ptr<U>(std::move(ptr)));
+   T *retval = dynamic_cast<T *> (ptr.get());
+
+   if (retval == nullptr) {
+      return CsSharedPointer<T>();
+   }
+
+   return CsSharedPointer<T>(std::move(ptr), retval);
 }
 
 template <typename T, typename U>
-CsSharedPointer<T> const_pointer_cast(CsSharedPointer<U> &&ptr)
+CsSharedPointer<T> const_pointer_cast(CsSharedPointer<U> &&ptr) noexcept
 {
-   return std::const_pointer_cast<T> (std::shared_ptr<U>(std::move(ptr)));
+   T *retval = const_cast<T *> (ptr.get());
+   return CsSharedPointer<T>(std::move(ptr), retval);
 }
 
 }   // end namespace
@@ -0,0 +1,389 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#ifndef LIB_CS_SMALL_VECTOR_H
+#define LIB_CS_SMALL_VECTOR_H
+
+#include <cs_pointer_traits.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace CsPointer {
+
+// stores up to N elements inline, growing and erasing relocate elements with memmove
+// when T is trivially relocatable instead of moving and destroying them one at a time
+
+template <typename T, std::size_t N = 8>
+class CsSmallVector
+{
+   static_assert(N > 0, "CsSmallVector requires inline storage for at least one element");
+
+ public:
+   using value_type      = T;
+   using size_type       = std::size_t;
+   using difference_type = std::ptrdiff_t;
+   using reference       = T &;
+   using const_reference = const T &;
+   using pointer         = T *;
+   using const_pointer   = const T *;
+   using iterator        = T *;
+   using const_iterator  = const T *;
+
+   CsSmallVector() noexcept
+      : m_data(inline_data()), m_size(0), m_capacity(N)
+   {
+   }
+
+   CsSmallVector(std::initializer_list<T> list)
+      : CsSmallVector()
+   {
+      reserve(list.size());
+
+      for (const T &item : list) {
+         ::new (static_cast<void *>(m_data + m_size)) T(item);
+         ++m_size;
+      }
+   }
+
+   CsSmallVector(const CsSmallVector &other)
+      : CsSmallVector()
+   {
+      reserve(other.m_size);
+
+      for (const T &item : other) {
+         ::new (static_cast<void *>(m_data + m_size)) T(item);
+         ++m_size;
+      }
+   }
+
+   CsSmallVector(CsSmallVector &&other) noexcept(cs_is_trivially_relocatable_v<T> ||
+         std::is_nothrow_move_constructible_v<T>)
+      : CsSmallVector()
+   {
+      take(other);
+   }
+
+   ~CsSmallVector() {
+      clear();
+      deallocate();
+   }
+
+   CsSmallVector &operator=(const CsSmallVector &other) {
+      if (this != &other) {
+         CsSmallVector tmp(other);
+
+         clear();
+         take(tmp);
+      }
+
+      return *this;
+   }
+
+   CsSmallVector &operator=(CsSmallVector &&other) noexcept(cs_is_trivially_relocatable_v<T> ||
+         std::is_nothrow_move_constructible_v<T>) {
+      if (this != &other) {
+         clear();
+         take(other);
+      }
+
+      return *this;
+   }
+
+   iterator begin() noexcept {
+      return m_data;
+   }
+
+   const_iterator begin() const noexcept {
+      return m_data;
+   }
+
+   iterator end() noexcept {
+      return m_data + m_size;
+   }
+
+   const_iterator end() const noexcept {
+      return m_data + m_size;
+   }
+
+   T *data() noexcept {
+      return m_data;
+   }
+
+   const T *data() const noexcept {
+      return m_data;
+   }
+
+   T &operator[](size_type index) noexcept {
+      return m_data[index];
+   }
+
+   const T &operator[](size_type index) const noexcept {
+      return m_data[index];
+   }
+
+   T &front() noexcept {
+      return m_data[0];
+   }
+
+   T &back() noexcept {
+      return m_data[m_size - 1];
+   }
+
+   size_type size() const noexcept {
+      return m_size;
+   }
+
+   size_type capacity() const noexcept {
+      return m_capacity;
+   }
+
+   bool empty() const noexcept {
+      return m_size == 0;
+   }
+
+   // true while the elements are stored inside the object
+   bool is_inline() const noexcept {
+      return m_data == inline_data();
+   }
+
+   void reserve(size_type capacity) {
+      if (capacity > m_capacity) {
+         reallocate(capacity);
+      }
+   }
+
+   void clear() noexcept {
+      std::destroy(m_data, m_data + m_size);
+      m_size = 0;
+   }
+
+   template <typename... Args>
+   T &emplace_back(Args &&... args) {
+      if (m_size == m_capacity) {
+         // construct first, args may refer to an existing element
+         size_type newCapacity = grow_capacity();
+         T *newData = allocate(newCapacity);
+
+         try {
+            ::new (static_cast<void *>(newData + m_size)) T(std::forward<Args>(args)...);
+
+         } catch (...) {
+            std::allocator<T>().deallocate(newData, newCapacity);
+            throw;
+         }
+
+         try {
+            relocate_to(m_data, m_size, newData);
+
+         } catch (...) {
+            newData[m_size].~T();
+            std::allocator<T>().deallocate(newData, newCapacity);
+            throw;
+         }
+
+         replace_data(newData, newCapacity);
+
+      } else {
+         ::new (static_cast<void *>(m_data + m_size)) T(std::forward<Args>(args)...);
+      }
+
+      ++m_size;
+
+      return back();
+   }
+
+   void push_back(const T &value) {
+      emplace_back(value);
+   }
+
+   void push_back(T &&value) {
+      emplace_back(std::move(value));
+   }
+
+   void pop_back() noexcept {
+      --m_size;
+      m_data[m_size].~T();
+   }
+
+   iterator insert(const_iterator pos, T value) {
+      size_type index = pos - m_data;
+
+      if (m_size == m_capacity) {
+         reserve(grow_capacity());
+      }
+
+      if constexpr (cs_is_trivially_relocatable_v<T>) {
+         cs_relocate(m_data + index, m_size - index, m_data + index + 1);
+         ::new (static_cast<void *>(m_data + index)) T(std::move(value));
+         ++m_size;
+
+      } else {
+         ::new (static_cast<void *>(m_data + m_size)) T(std::move(value));
+         ++m_size;
+
+         std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+      }
+
+      return m_data + index;
+   }
+
+   iterator erase(const_iterator pos) {
+      return erase(pos, pos + 1);
+   }
+
+   iterator erase(const_iterator first, const_iterator last) {
+      T *dest = m_data + (first - m_data);
+      T *tail = m_data + (last - m_data);
+
+      size_type count = last - first;
+
+      if constexpr (cs_is_trivially_relocatable_v<T>) {
+         std::destroy(dest, tail);
+         cs_relocate(tail, end() - tail, dest);
+
+      } else {
+         std::move(tail, end(), dest);
+         std::destroy(end() - count, end());
+      }
+
+      m_size -= count;
+
+      return dest;
+   }
+
+   // moves the element at index source to index dest, shifting the elements in between
+   void move_element(size_type source, size_type dest) {
+      cs_relocate_element(m_data, source, dest);
+   }
+
+   void swap(CsSmallVector &other) {
+      CsSmallVector tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+   }
+
+ private:
+   T *inline_data() noexcept {
+      return reinterpret_cast<T *>(m_storage);
+   }
+
+   const T *inline_data() const noexcept {
+      return reinterpret_cast<const T *>(m_storage);
+   }
+
+   size_type grow_capacity() const noexcept {
+      return m_capacity * 2;
+   }
+
+   static T *allocate(size_type capacity) {
+      return std::allocator<T>().allocate(capacity);
+   }
+
+   void deallocate() noexcept {
+      if (! is_inline()) {
+         std::allocator<T>().deallocate(m_data, m_capacity);
+      }
+   }
+
+   void replace_data(T *newData, size_type capacity) noexcept {
+      deallocate();
+
+      m_data     = newData;
+      m_capacity = capacity;
+   }
+
+   void reallocate(size_type capacity) {
+      T *newData = allocate(capacity);
+
+      try {
+         relocate_to(m_data, m_size, newData);
+
+      } catch (...) {
+         std::allocator<T>().deallocate(newData, capacity);
+         throw;
+      }
+
+      replace_data(newData, capacity);
+   }
+
+   // moves count elements to separate uninitialized storage, when the move constructor may
+   // throw the source elements are copied if possible and destroyed only after every new
+   // element was constructed, an exception leaves the source unchanged as std::vector does
+   static void relocate_to(T *source, size_type count, T *dest) {
+      if constexpr (cs_is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+         cs_relocate(source, count, dest);
+
+      } else {
+         size_type index = 0;
+
+         try {
+            for (; index < count; ++index) {
+               ::new (static_cast<void *>(dest + index)) T(std::move_if_noexcept(source[index]));
+            }
+
+         } catch (...) {
+            std::destroy(dest, dest + index);
+            throw;
+         }
+
+         std::destroy(source, source + count);
+      }
+   }
+
+   // this must be empty, other is left empty
+   void take(CsSmallVector &other) {
+      if (other.is_inline()) {
+         reserve(other.m_size);
+         relocate_to(other.m_data, other.m_size, m_data);
+
+      } else {
+         deallocate();
+
+         m_data     = other.m_data;
+         m_capacity = other.m_capacity;
+
+         other.m_data     = other.inline_data();
+         other.m_capacity = N;
+      }
+
+      m_size       = other.m_size;
+      other.m_size = 0;
+   }
+
+   T *m_data;
+   size_type m_size;
+   size_type m_capacity;
+
+   alignas(T) unsigned char m_storage[N * sizeof(T)];
+};
+
+template <typename T, std::size_t N>
+void swap(CsSmallVector<T, N> &list1, CsSmallVector<T, N> &list2)
+{
+   list1.swap(list2);
+}
+
+}   // end namespace
+
+#endif
@@ -76,6 +76,10 @@ CsUniqueArrayPointer<T> make_unique(std::size_t size)
    return std::make_unique<T>(size);
 }
 
+template <typename T, typename Deleter>
+struct cs_is_trivially_relocatable<CsUniqueArrayPointer<T, Deleter>> : cs_is_trivially_relocatable<Deleter> {
+};
+
 }   // end namespace
 
 #endif
@@ -19,6 +19,8 @@
 #ifndef LIB_CS_UNIQUE_POINTER_H
 #define LIB_CS_UNIQUE_POINTER_H
 
+#include <cs_pointer_traits.h>
+
 #include <compare>
 #include <memory>
 
@@ -171,6 +173,10 @@ void swap(CsUniquePointer<T, Deleter> &ptr1, CsUniquePointer<T, Deleter> &ptr2)
    ptr1.swap(ptr2);
 }
 
+template <typename T, typename Deleter>
+struct cs_is_trivially_relocatable<CsUniquePointer<T, Deleter>> : cs_is_trivially_relocatable<Deleter> {
+};
+
 }   // end namespace
 
 #endif
@@ -146,6 +146,10 @@ void swap(CsWeakPointer<T> &ptr1, CsWeakPointer<T> &ptr2) noexcept
    ptr1.swap(ptr2);
 }
 
+template <typename T>
+struct cs_is_trivially_relocatable<CsWeakPointer<T>> : std::true_type {
+};
+
 }   // end namespace
 
 #endif
@@ -13,11 +13,27 @@ target_include_directories(CsPointer
 )
 
 set(CS_POINTER_INCLUDES
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_atomic_intrusive_pointer.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_cow_pointer.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_enable_shared.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_biased.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_deferred.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_hash_set.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_layout.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_list.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_pointer.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_reclaim.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_ref.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_sharded.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_stats.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_teardown.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_intrusive_weak_pointer.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_nodemanager.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_object_registry.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_pointer_traits.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_shared_pointer.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_shared_array_pointer.h
+   ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_small_vector.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_unique_pointer.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_unique_array_pointer.h
    ${CMAKE_CURRENT_SOURCE_DIR}/src/cs_weak_pointer.h
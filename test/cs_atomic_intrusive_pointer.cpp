@@ -0,0 +1,142 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_atomic_intrusive_pointer.h>
+
+#include <cs_catch2.h>
+
+#include <thread>
+#include <vector>
+
+class Route : public CsPointer::CsIntrusiveBase
+{
+ public:
+   Route(int value)
+      : m_value(value)
+   {
+   }
+
+   int value() const {
+      return m_value;
+   }
+
+ private:
+   int m_value;
+};
+
+using RoutePtr = CsPointer::CsIntrusivePointer<Route, CsPointer::CsIntrusiveReclaimPolicy<>>;
+
+TEST_CASE("CsAtomicIntrusivePointer traits", "[cs_atomic_intrusivepointer]")
+{
+   REQUIRE(std::is_copy_constructible_v<CsPointer::CsAtomicIntrusivePointer<Route>> == false);
+   REQUIRE(std::is_copy_assignable_v<CsPointer::CsAtomicIntrusivePointer<Route>> == false);
+
+   REQUIRE(CsPointer::cs_is_reclaim_policy_v<CsPointer::CsIntrusiveReclaimPolicy<>> == true);
+   REQUIRE(CsPointer::cs_is_reclaim_policy_v<CsPointer::CsIntrusiveDefaultPolicy> == false);
+
+   CsPointer::CsAtomicIntrusivePointer<Route> slot;
+
+   REQUIRE(slot.is_lock_free() == true);
+}
+
+TEST_CASE("CsAtomicIntrusivePointer load_store", "[cs_atomic_intrusivepointer]")
+{
+   RoutePtr ptr1 = CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(1);
+
+   CsPointer::CsAtomicIntrusivePointer<Route> slot(ptr1);
+
+   REQUIRE(ptr1.use_count() == 2);
+
+   RoutePtr ptr2 = slot.load();
+
+   REQUIRE(ptr2 == ptr1);
+   REQUIRE(ptr1.use_count() == 3);
+
+   slot.store(nullptr);
+
+   REQUIRE(slot.load() == nullptr);
+   REQUIRE(ptr1.use_count() == 2);
+}
+
+TEST_CASE("CsAtomicIntrusivePointer exchange", "[cs_atomic_intrusivepointer]")
+{
+   RoutePtr ptr1 = CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(1);
+   RoutePtr ptr2 = CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(2);
+
+   CsPointer::CsAtomicIntrusivePointer<Route> slot(ptr1);
+
+   RoutePtr oldPtr = slot.exchange(ptr2);
+
+   REQUIRE(oldPtr == ptr1);
+   REQUIRE(slot.load()->value() == 2);
+
+   REQUIRE(ptr1.use_count() == 2);
+   REQUIRE(ptr2.use_count() == 2);
+}
+
+TEST_CASE("CsAtomicIntrusivePointer compare_exchange", "[cs_atomic_intrusivepointer]")
+{
+   RoutePtr ptr1 = CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(1);
+   RoutePtr ptr2 = CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(2);
+   RoutePtr ptr3 = CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(3);
+
+   CsPointer::CsAtomicIntrusivePointer<Route> slot(ptr1);
+
+   RoutePtr expected = ptr2;
+
+   REQUIRE(slot.compare_exchange_strong(expected, ptr3) == false);
+   REQUIRE(expected == ptr1);
+
+   REQUIRE(slot.compare_exchange_strong(expected, ptr3) == true);
+   REQUIRE(slot.load() == ptr3);
+
+   REQUIRE(ptr1.use_count() == 2);
+   REQUIRE(ptr3.use_count() == 2);
+}
+
+TEST_CASE("CsAtomicIntrusivePointer threads", "[cs_atomic_intrusivepointer]")
+{
+   CsPointer::CsAtomicIntrusivePointer<Route> slot(CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(0));
+
+   std::vector<std::thread> threads;
+   std::atomic<bool> failed = false;
+
+   for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&slot, &failed, i] () {
+         for (int j = 0; j < 1000; ++j) {
+            if (i == 0) {
+               slot.store(CsPointer::make_intrusive<Route, CsPointer::CsIntrusiveReclaimPolicy<>>(j));
+
+            } else {
+               RoutePtr ptr = slot.load();
+
+               if (ptr == nullptr || ptr->value() < 0 || ptr.use_count() < 1) {
+                  failed = true;
+               }
+            }
+         }
+      });
+   }
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   REQUIRE(failed == false);
+   REQUIRE(slot.load()->value() == 999);
+}
@@ -0,0 +1,197 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_cow_pointer.h>
+
+#include <cs_catch2.h>
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+int s_copyCount = 0;
+
+}
+
+class Document : public CsPointer::CsIntrusiveBase_CM
+{
+ public:
+   Document() = default;
+
+   Document(std::vector<int> values)
+      : m_values(std::move(values))
+   {
+   }
+
+   Document(const Document &other)
+      : CsPointer::CsIntrusiveBase_CM(other), m_values(other.m_values)
+   {
+      ++s_copyCount;
+   }
+
+   std::vector<int> m_values;
+};
+
+class Shape : public CsPointer::CsIntrusiveBase_CM
+{
+ public:
+   virtual Shape *clone() const = 0;
+   virtual int sides() const = 0;
+
+   int m_size = 0;
+};
+
+class Square : public Shape
+{
+ public:
+   Square *clone() const override {
+      return new Square(*this);
+   }
+
+   int sides() const override {
+      return 4;
+   }
+};
+
+namespace Geometry {
+
+class Point : public CsPointer::CsIntrusiveBase_CM
+{
+ public:
+   int m_x = 0;
+   int m_y = 0;
+
+   static inline int s_cloneCount = 0;
+};
+
+Point *cs_cow_clone(const Point *ptr)
+{
+   ++Point::s_cloneCount;
+   return new Point(*ptr);
+}
+
+}
+
+TEST_CASE("CsCowPointer traits", "[cs_cowpointer]")
+{
+   REQUIRE(std::is_copy_constructible_v<CsPointer::CsCowPointer<Document>> == true);
+   REQUIRE(std::is_move_constructible_v<CsPointer::CsCowPointer<Document>> == true);
+
+   REQUIRE(std::is_copy_assignable_v<CsPointer::CsCowPointer<Document>> == true);
+   REQUIRE(std::is_move_assignable_v<CsPointer::CsCowPointer<Document>> == true);
+
+   REQUIRE(sizeof(CsPointer::CsCowPointer<Document>) == sizeof(void *));
+}
+
+TEST_CASE("CsCowPointer empty", "[cs_cowpointer]")
+{
+   CsPointer::CsCowPointer<Document> ptr;
+
+   REQUIRE(ptr == nullptr);
+   REQUIRE(ptr.is_null() == true);
+   REQUIRE(ptr.is_shared() == false);
+
+   ptr.detach();
+
+   REQUIRE(ptr.data() == nullptr);
+}
+
+TEST_CASE("CsCowPointer read", "[cs_cowpointer]")
+{
+   s_copyCount = 0;
+
+   CsPointer::CsCowPointer<Document> ptr1 = CsPointer::make_cow<Document>(std::vector<int>{1, 2, 3});
+   const CsPointer::CsCowPointer<Document> ptr2 = ptr1;
+
+   REQUIRE(ptr1.use_count() == 2);
+   REQUIRE(ptr2->m_values.size() == 3);
+   REQUIRE(ptr2.constData() == std::as_const(ptr1).data());
+
+   REQUIRE(s_copyCount == 0);
+   REQUIRE(ptr1.is_shared() == true);
+}
+
+TEST_CASE("CsCowPointer write", "[cs_cowpointer]")
+{
+   s_copyCount = 0;
+
+   CsPointer::CsCowPointer<Document> ptr1 = CsPointer::make_cow<Document>(std::vector<int>{1, 2, 3});
+   CsPointer::CsCowPointer<Document> ptr2 = ptr1;
+
+   ptr2->m_values.push_back(4);
+
+   REQUIRE(s_copyCount == 1);
+   REQUIRE(ptr1.use_count() == 1);
+   REQUIRE(ptr2.use_count() == 1);
+
+   REQUIRE(ptr1->m_values.size() == 3);
+   REQUIRE(ptr2->m_values.size() == 4);
+
+   // unique, no further copies
+   ptr2->m_values.push_back(5);
+   (*ptr1).m_values.clear();
+
+   REQUIRE(s_copyCount == 1);
+   REQUIRE(ptr1->m_values.empty() == true);
+   REQUIRE(ptr2->m_values.size() == 5);
+}
+
+TEST_CASE("CsCowPointer clone", "[cs_cowpointer]")
+{
+   CsPointer::CsCowPointer<Shape> ptr1(new Square);
+   CsPointer::CsCowPointer<Shape> ptr2 = ptr1;
+
+   ptr2->m_size = 10;
+
+   REQUIRE(ptr1->m_size == 0);
+   REQUIRE(ptr2->m_size == 10);
+   REQUIRE(ptr2->sides() == 4);
+
+   Geometry::Point::s_cloneCount = 0;
+
+   CsPointer::CsCowPointer<Geometry::Point> ptr3 = CsPointer::make_cow<Geometry::Point>();
+   CsPointer::CsCowPointer<Geometry::Point> ptr4 = ptr3;
+
+   ptr4->m_x = 5;
+
+   REQUIRE(Geometry::Point::s_cloneCount == 1);
+   REQUIRE(ptr3->m_x == 0);
+   REQUIRE(ptr4->m_x == 5);
+}
+
+TEST_CASE("CsCowPointer immortal", "[cs_cowpointer]")
+{
+   s_copyCount = 0;
+
+   CsPointer::CsCowPointer<Document, CsPointer::CsIntrusiveImmortalPolicy<>> ptr1 =
+         CsPointer::make_cow<Document, CsPointer::CsIntrusiveImmortalPolicy<>>(std::vector<int>{1});
+
+   CsPointer::freeze(ptr1.toIntrusivePointer());
+
+   const Document *frozenPtr = ptr1.constData();
+
+   // frozen objects are never modified in place
+   ptr1->m_values.push_back(2);
+
+   REQUIRE(s_copyCount == 1);
+   REQUIRE(ptr1.constData() != frozenPtr);
+   REQUIRE(frozenPtr->m_values.size() == 1);
+
+   delete frozenPtr;
+}
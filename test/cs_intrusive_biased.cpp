@@ -0,0 +1,152 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_biased.h>
+
+#include <cs_catch2.h>
+
+#include <thread>
+
+namespace {
+
+int s_destroyCount = 0;
+
+}
+
+class Counter : public CsPointer::CsIntrusiveBase_Biased
+{
+ public:
+   Counter(int value)
+      : m_value(value)
+   {
+   }
+
+   ~Counter()
+   {
+      ++s_destroyCount;
+   }
+
+   int value() const {
+      return m_value;
+   }
+
+ private:
+   int m_value;
+};
+
+using BiasedPtr = CsPointer::CsIntrusivePointer<Counter, CsPointer::CsIntrusiveBiasedPolicy>;
+
+TEST_CASE("CsIntrusiveBiased owner", "[cs_intrusive_biased]")
+{
+   s_destroyCount = 0;
+
+   {
+      BiasedPtr ptr1 = CsPointer::make_intrusive<Counter, CsPointer::CsIntrusiveBiasedPolicy>(5);
+      BiasedPtr ptr2 = ptr1;
+
+      REQUIRE(ptr1.use_count() == 2);
+      REQUIRE(ptr2->value() == 5);
+
+      ptr2.reset();
+
+      REQUIRE(ptr1.use_count() == 1);
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveBiased shared", "[cs_intrusive_biased]")
+{
+   s_destroyCount = 0;
+
+   BiasedPtr ptr = CsPointer::make_intrusive<Counter, CsPointer::CsIntrusiveBiasedPolicy>(7);
+
+   std::thread worker([copy = ptr] () mutable {
+      BiasedPtr tmp = copy;
+      REQUIRE(tmp->value() == 7);
+   });
+
+   worker.join();
+
+   REQUIRE(ptr.use_count() == 1);
+
+   ptr.reset();
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveBiased queued", "[cs_intrusive_biased]")
+{
+   s_destroyCount = 0;
+
+   BiasedPtr ptr = CsPointer::make_intrusive<Counter, CsPointer::CsIntrusiveBiasedPolicy>(9);
+
+   // reference created on the owner thread is released on the worker thread
+   std::thread worker([moved = std::move(ptr)] () mutable {
+      moved.reset();
+   });
+
+   worker.join();
+
+   REQUIRE(s_destroyCount == 0);
+
+   CsPointer::CsIntrusiveBiasedPolicy::merge_queued();
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveBiased unbias", "[cs_intrusive_biased]")
+{
+   s_destroyCount = 0;
+
+   BiasedPtr ptr = CsPointer::make_intrusive<Counter, CsPointer::CsIntrusiveBiasedPolicy>(11);
+   CsPointer::CsIntrusiveBiasedPolicy::unbias(ptr.get());
+
+   std::thread worker([moved = std::move(ptr)] () mutable {
+      REQUIRE(moved.use_count() == 1);
+      moved.reset();
+
+      REQUIRE(s_destroyCount == 1);
+   });
+
+   worker.join();
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveBiased release_if", "[cs_intrusive_biased]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Counter> ptr = CsPointer::make_intrusive<Counter>(13);
+   CsPointer::CsIntrusivePointer<Counter> copy = ptr;
+
+   REQUIRE(ptr.release_if() == nullptr);
+
+   copy.reset();
+
+   Counter *rawPtr = ptr.release_if();
+
+   REQUIRE(rawPtr != nullptr);
+   REQUIRE(ptr == nullptr);
+   REQUIRE(s_destroyCount == 0);
+
+   delete rawPtr;
+
+   REQUIRE(s_destroyCount == 1);
+}
@@ -0,0 +1,198 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_deferred.h>
+#include <cs_intrusive_stats.h>
+#include <cs_nodemanager.h>
+
+#include <cs_catch2.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> s_destroyCount = 0;
+
+}
+
+class Task : public CsPointer::CsIntrusiveBase
+{
+ public:
+   ~Task()
+   {
+      ++s_destroyCount;
+   }
+};
+
+using DeferredPolicy = CsPointer::CsIntrusiveDeferredPolicy<>;
+
+class Branch : public CsPointer::CsNodeManager<Branch, DeferredPolicy>, public CsPointer::CsIntrusiveBase
+{
+ public:
+   ~Branch()
+   {
+      ++s_destroyCount;
+   }
+};
+
+TEST_CASE("CsIntrusiveDeferred drain", "[cs_intrusive_deferred]")
+{
+   CsPointer::CsDeferredQueue::global().drain();
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Task, DeferredPolicy> ptr1 = CsPointer::make_intrusive<Task, DeferredPolicy>();
+   CsPointer::CsIntrusivePointer<Task, DeferredPolicy> ptr2 = ptr1;
+
+   ptr1.reset();
+   ptr2.reset();
+
+   REQUIRE(s_destroyCount == 0);
+   REQUIRE(CsPointer::CsDeferredQueue::global().empty() == false);
+
+   REQUIRE(CsPointer::CsDeferredQueue::global().drain() == 1);
+   REQUIRE(s_destroyCount == 1);
+   REQUIRE(CsPointer::CsDeferredQueue::global().empty() == true);
+}
+
+TEST_CASE("CsIntrusiveDeferred release_range", "[cs_intrusive_deferred]")
+{
+   CsPointer::CsDeferredQueue::global().drain();
+   s_destroyCount = 0;
+
+   std::vector<CsPointer::CsIntrusivePointer<Task, DeferredPolicy>> list;
+
+   for (int i = 0; i < 100; ++i) {
+      list.push_back(CsPointer::make_intrusive<Task, DeferredPolicy>());
+   }
+
+   CsPointer::release_intrusive_range(list.data(), list.data() + list.size());
+
+   // destroyed through the policy, not deleted in place
+   REQUIRE(s_destroyCount == 0);
+
+   REQUIRE(CsPointer::CsDeferredQueue::global().drain() == 100);
+   REQUIRE(s_destroyCount == 100);
+}
+
+TEST_CASE("CsIntrusiveDeferred wrapped_release_range", "[cs_intrusive_deferred]")
+{
+   using StatsPolicy    = CsPointer::CsIntrusiveStatsPolicy<DeferredPolicy>;
+   using ImmortalPolicy = CsPointer::CsIntrusiveImmortalPolicy<DeferredPolicy>;
+
+   CsPointer::CsDeferredQueue::global().drain();
+   s_destroyCount = 0;
+
+   {
+      std::vector<CsPointer::CsIntrusivePointer<Task, StatsPolicy>> list;
+
+      for (int i = 0; i < 10; ++i) {
+         list.push_back(CsPointer::make_intrusive<Task, StatsPolicy>());
+      }
+
+      CsPointer::release_intrusive_range(list.data(), list.data() + list.size());
+
+      // node manager of a non-node type releases through the same path
+      CsPointer::CsNodeManager<Task, ImmortalPolicy> node;
+
+      for (int i = 0; i < 10; ++i) {
+         node.add_child(CsPointer::make_intrusive<Task, ImmortalPolicy>());
+      }
+
+      node.clear();
+   }
+
+   REQUIRE(s_destroyCount == 0);
+
+   REQUIRE(CsPointer::CsDeferredQueue::global().drain() == 20);
+   REQUIRE(s_destroyCount == 20);
+}
+
+TEST_CASE("CsIntrusiveDeferred cascade", "[cs_intrusive_deferred]")
+{
+   CsPointer::CsDeferredQueue::global().drain();
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Branch, DeferredPolicy> root = CsPointer::make_intrusive<Branch, DeferredPolicy>();
+   Branch *parent = root.get();
+
+   for (int i = 0; i < 1000; ++i) {
+      CsPointer::CsIntrusivePointer<Branch, DeferredPolicy> child = CsPointer::make_intrusive<Branch, DeferredPolicy>();
+
+      parent->add_child(child);
+      parent = child.get();
+   }
+
+   root.reset();
+
+   REQUIRE(s_destroyCount == 0);
+
+   // children released by a destructor are destroyed by the same drain
+   REQUIRE(CsPointer::CsDeferredQueue::global().drain() == 1001);
+   REQUIRE(s_destroyCount == 1001);
+}
+
+TEST_CASE("CsIntrusiveDeferred clear", "[cs_intrusive_deferred]")
+{
+   CsPointer::CsDeferredQueue::global().drain();
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Branch, DeferredPolicy> root = CsPointer::make_intrusive<Branch, DeferredPolicy>();
+   Branch *parent = root.get();
+
+   for (int i = 0; i < 1000; ++i) {
+      CsPointer::CsIntrusivePointer<Branch, DeferredPolicy> child = CsPointer::make_intrusive<Branch, DeferredPolicy>();
+
+      parent->add_child(child);
+      parent = child.get();
+   }
+
+   // nothing is destroyed on the calling thread
+   root->clear();
+
+   REQUIRE(s_destroyCount == 0);
+   REQUIRE(CsPointer::CsDeferredQueue::global().empty() == false);
+
+   REQUIRE(CsPointer::CsDeferredQueue::global().drain() == 1000);
+   REQUIRE(s_destroyCount == 1000);
+}
+
+TEST_CASE("CsIntrusiveDeferred thread", "[cs_intrusive_deferred]")
+{
+   CsPointer::CsDeferredQueue queue;
+   s_destroyCount = 0;
+
+   queue.start();
+
+   for (int i = 0; i < 100; ++i) {
+      queue.push(new Task);
+   }
+
+   auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+   while (s_destroyCount != 100 && std::chrono::steady_clock::now() < timeout) {
+      std::this_thread::yield();
+   }
+
+   queue.stop();
+
+   REQUIRE(s_destroyCount == 100);
+   REQUIRE(queue.empty() == true);
+}
@@ -0,0 +1,165 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_hash_set.h>
+
+#include <cs_catch2.h>
+
+#include <string>
+
+namespace {
+
+int s_destroyCount = 0;
+
+}
+
+class Session : public CsPointer::CsIntrusiveBase, public CsPointer::CsIntrusiveHashSetHook<>
+{
+ public:
+   Session(int id, std::string user)
+      : m_id(id), m_user(user)
+   {
+   }
+
+   ~Session()
+   {
+      ++s_destroyCount;
+   }
+
+   int m_id;
+   std::string m_user;
+};
+
+struct SessionHash {
+   std::size_t operator()(const Session &session) const {
+      return std::hash<int>()(session.m_id);
+   }
+
+   std::size_t operator()(int id) const {
+      return std::hash<int>()(id);
+   }
+};
+
+struct SessionEqual {
+   bool operator()(const Session &session1, const Session &session2) const {
+      return session1.m_id == session2.m_id;
+   }
+
+   bool operator()(const Session &session, int id) const {
+      return session.m_id == id;
+   }
+};
+
+using SessionSet = CsPointer::CsIntrusiveHashSet<Session, SessionHash, SessionEqual>;
+
+TEST_CASE("CsIntrusiveHashSet insert", "[cs_intrusive_hash_set]")
+{
+   s_destroyCount = 0;
+
+   {
+      SessionSet set;
+
+      REQUIRE(set.empty() == true);
+      REQUIRE(set.find(1) == nullptr);
+
+      CsPointer::CsIntrusivePointer<Session> ptr = CsPointer::make_intrusive<Session>(1, "ansel");
+
+      REQUIRE(set.insert(ptr) == true);
+      REQUIRE(set.insert(CsPointer::make_intrusive<Session>(1, "duplicate")) == false);
+      REQUIRE(s_destroyCount == 1);
+
+      REQUIRE(set.size() == 1);
+      REQUIRE(ptr.use_count() == 2);
+      REQUIRE(set.find(1) == ptr);
+      REQUIRE(set.find(1)->m_user == "ansel");
+      REQUIRE(set.contains(2) == false);
+   }
+
+   REQUIRE(s_destroyCount == 2);
+}
+
+TEST_CASE("CsIntrusiveHashSet grow", "[cs_intrusive_hash_set]")
+{
+   s_destroyCount = 0;
+
+   {
+      SessionSet set;
+
+      for (int i = 0; i < 1000; ++i) {
+         set.insert(CsPointer::make_intrusive<Session>(i, std::to_string(i)));
+      }
+
+      REQUIRE(set.size() == 1000);
+      REQUIRE(set.bucket_count() >= 1000);
+
+      int count = 0;
+
+      for (const Session &item : set) {
+         REQUIRE(set.find(item.m_id)->m_user == item.m_user);
+         ++count;
+      }
+
+      REQUIRE(count == 1000);
+
+      SessionSet other = std::move(set);
+
+      REQUIRE(set.empty() == true);
+      REQUIRE(other.contains(999) == true);
+   }
+
+   REQUIRE(s_destroyCount == 1000);
+}
+
+TEST_CASE("CsIntrusiveHashSet remove", "[cs_intrusive_hash_set]")
+{
+   s_destroyCount = 0;
+
+   SessionSet set(64);
+
+   REQUIRE(set.bucket_count() == 64);
+
+   CsPointer::CsIntrusivePointer<Session> ptr = CsPointer::make_intrusive<Session>(2, "barbara");
+
+   set.insert(CsPointer::make_intrusive<Session>(1, "ansel"));
+   set.insert(ptr);
+   set.insert(CsPointer::make_intrusive<Session>(3, "other"));
+
+   REQUIRE(set.bucket_count() == 64);
+
+   REQUIRE(set.remove(1) == true);
+   REQUIRE(set.remove(1) == false);
+   REQUIRE(s_destroyCount == 1);
+
+   // unlink given the object
+   set.erase(*ptr);
+
+   REQUIRE(set.contains(2) == false);
+   REQUIRE(ptr.use_count() == 1);
+   REQUIRE(ptr->is_linked() == false);
+
+   CsPointer::CsIntrusivePointer<Session> last = set.take(*set.begin());
+
+   REQUIRE(set.empty() == true);
+   REQUIRE(last->m_id == 3);
+   REQUIRE(last.use_count() == 1);
+
+   set.insert(last);
+   set.clear();
+
+   REQUIRE(last.use_count() == 1);
+}
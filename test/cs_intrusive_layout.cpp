@@ -0,0 +1,203 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_layout.h>
+
+#include <cs_catch2.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+int s_destroyCount = 0;
+
+template <typename T>
+constexpr bool can_array_new = requires { new T[2]; };
+
+template <typename T>
+constexpr bool can_class_new = requires { T::operator new(sizeof(T)); };
+
+template <typename T>
+constexpr bool can_placement_new = requires (void *buffer) { ::new (buffer) T(); };
+
+}
+
+class Ledger : public CsPointer::CsIntrusiveBase_Aligned
+{
+ public:
+   ~Ledger()
+   {
+      ++s_destroyCount;
+   }
+
+   int m_value = 0;
+};
+
+class Payload
+{
+ public:
+   virtual ~Payload() = default;
+
+   std::string m_name = "payload";
+};
+
+// header base is not the first base class
+class Journal : public Payload, public CsPointer::CsIntrusiveBase_Header
+{
+ public:
+   Journal(const CsPointer::CsIntrusiveHeaderKey &key)
+      : CsIntrusiveBase_Header(key)
+   {
+   }
+
+   Journal(const CsPointer::CsIntrusiveHeaderKey &key, int value)
+      : CsIntrusiveBase_Header(key), m_value(value)
+   {
+   }
+
+   ~Journal()
+   {
+      ++s_destroyCount;
+   }
+
+   int m_value = 0;
+};
+
+class alignas(128) WideJournal : public CsPointer::CsIntrusiveBase_Header
+{
+ public:
+   using CsIntrusiveBase_Header::CsIntrusiveBase_Header;
+
+   ~WideJournal()
+   {
+      ++s_destroyCount;
+   }
+
+   int m_value = 0;
+};
+
+TEST_CASE("CsIntrusiveLayout aligned", "[cs_intrusive_layout]")
+{
+   s_destroyCount = 0;
+
+   REQUIRE(alignof(Ledger) == CsPointer::CsCacheLineSize);
+   REQUIRE(sizeof(Ledger) == 3 * CsPointer::CsCacheLineSize);
+
+   {
+      CsPointer::CsIntrusivePointer<Ledger> ptr1 = CsPointer::make_intrusive<Ledger>();
+      CsPointer::CsIntrusivePointer<Ledger> ptr2 = ptr1;
+
+      auto address = reinterpret_cast<std::uintptr_t>(ptr1.get());
+      auto member  = reinterpret_cast<std::uintptr_t>(&ptr1->m_value);
+
+      REQUIRE(address % CsPointer::CsCacheLineSize == 0);
+      REQUIRE(member - address == 2 * CsPointer::CsCacheLineSize);
+      REQUIRE(ptr1.use_count() == 2);
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveLayout header", "[cs_intrusive_layout]")
+{
+   s_destroyCount = 0;
+
+   REQUIRE(sizeof(Journal) < CsPointer::CsCacheLineSize);
+
+   // array new and allocate_intrusive() would not reserve the header
+   REQUIRE(can_array_new<Journal> == false);
+   REQUIRE(can_class_new<Journal> == true);
+   REQUIRE(can_array_new<Ledger> == true);
+
+   // stack objects, members and placement new would not reserve the header
+   REQUIRE(std::is_default_constructible_v<Journal> == false);
+   REQUIRE(std::is_default_constructible_v<WideJournal> == false);
+   REQUIRE(std::is_default_constructible_v<CsPointer::CsIntrusiveHeaderKey> == false);
+   REQUIRE(std::is_copy_constructible_v<CsPointer::CsIntrusiveHeaderKey> == false);
+   REQUIRE(can_placement_new<Journal> == false);
+   REQUIRE(can_placement_new<Ledger> == true);
+
+   {
+      CsPointer::CsIntrusivePointer<Journal> ptr1 = CsPointer::make_intrusive<Journal>();
+      CsPointer::CsIntrusivePointer<Journal> ptr2 = ptr1;
+
+      REQUIRE(reinterpret_cast<std::uintptr_t>(ptr1.get()) % CsPointer::CsCacheLineSize == 0);
+      REQUIRE(ptr1.use_count() == 2);
+      REQUIRE(ptr1->m_name == "payload");
+
+      ptr2.reset();
+
+      REQUIRE(ptr1.use_count() == 1);
+      REQUIRE(s_destroyCount == 0);
+
+      Journal *rawPtr = ptr1.try_take_unique();
+
+      REQUIRE(rawPtr != nullptr);
+
+      ptr1.reset(rawPtr);
+
+      REQUIRE(ptr1.use_count() == 1);
+   }
+
+   REQUIRE(s_destroyCount == 1);
+
+   {
+      CsPointer::CsIntrusivePointer<Journal> ptr = CsPointer::make_intrusive<Journal>(5);
+
+      REQUIRE(ptr->m_value == 5);
+   }
+
+   REQUIRE(s_destroyCount == 2);
+
+   {
+      CsPointer::CsIntrusivePointer<WideJournal> ptr = CsPointer::make_intrusive<WideJournal>();
+
+      REQUIRE(reinterpret_cast<std::uintptr_t>(ptr.get()) % 128 == 0);
+      REQUIRE(ptr.use_count() == 1);
+   }
+
+   REQUIRE(s_destroyCount == 3);
+}
+
+TEST_CASE("CsIntrusiveLayout threads", "[cs_intrusive_layout]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Journal> ptr = CsPointer::make_intrusive<Journal>();
+   std::vector<std::thread> threads;
+
+   for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([copy = ptr] () {
+         for (int j = 0; j < 1000; ++j) {
+            CsPointer::CsIntrusivePointer<Journal> tmp = copy;
+         }
+      });
+   }
+
+   ptr.reset();
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
@@ -0,0 +1,200 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_list.h>
+
+#include <cs_catch2.h>
+
+#include <vector>
+
+namespace {
+
+int s_destroyCount = 0;
+
+struct RunTag;
+
+}
+
+class Job : public CsPointer::CsIntrusiveBase, public CsPointer::CsIntrusiveListHook<>,
+      public CsPointer::CsIntrusiveListHook<RunTag>
+{
+ public:
+   Job(int id)
+      : m_id(id)
+   {
+   }
+
+   ~Job()
+   {
+      ++s_destroyCount;
+   }
+
+   int m_id;
+};
+
+using JobList    = CsPointer::CsIntrusiveList<Job>;
+using RunJobList = CsPointer::CsIntrusiveList<Job, CsPointer::CsIntrusiveDefaultPolicy, RunTag>;
+
+namespace {
+
+std::vector<int> list_ids(const JobList &list)
+{
+   std::vector<int> retval;
+
+   for (const Job &item : list) {
+      retval.push_back(item.m_id);
+   }
+
+   return retval;
+}
+
+}
+
+TEST_CASE("CsIntrusiveList insert", "[cs_intrusive_list]")
+{
+   s_destroyCount = 0;
+
+   {
+      CsPointer::CsIntrusivePointer<Job> ptr = CsPointer::make_intrusive<Job>(2);
+
+      JobList list;
+
+      REQUIRE(list.empty() == true);
+
+      list.push_back(ptr);
+      list.push_back(CsPointer::make_intrusive<Job>(3));
+      list.push_front(CsPointer::make_intrusive<Job>(1));
+
+      REQUIRE(list.size() == 3);
+      REQUIRE(list_ids(list) == std::vector<int>{1, 2, 3});
+      REQUIRE(list.front().m_id == 1);
+      REQUIRE(list.back().m_id == 3);
+
+      REQUIRE(ptr.use_count() == 2);
+      REQUIRE(ptr->CsPointer::CsIntrusiveListHook<>::is_linked() == true);
+
+      auto iter = list.end();
+      --iter;
+
+      REQUIRE(iter->m_id == 3);
+
+      list.insert(iter, CsPointer::make_intrusive<Job>(4));
+
+      REQUIRE(list_ids(list) == std::vector<int>{1, 2, 4, 3});
+   }
+
+   REQUIRE(s_destroyCount == 4);
+}
+
+TEST_CASE("CsIntrusiveList erase", "[cs_intrusive_list]")
+{
+   s_destroyCount = 0;
+
+   JobList list;
+   CsPointer::CsIntrusivePointer<Job> ptr = CsPointer::make_intrusive<Job>(2);
+
+   list.push_back(CsPointer::make_intrusive<Job>(1));
+   list.push_back(ptr);
+   list.push_back(CsPointer::make_intrusive<Job>(3));
+
+   // unlink given the object
+   list.erase(*ptr);
+
+   REQUIRE(list_ids(list) == std::vector<int>{1, 3});
+   REQUIRE(ptr.use_count() == 1);
+   REQUIRE(ptr->CsPointer::CsIntrusiveListHook<>::is_linked() == false);
+
+   auto iter = list.erase(list.begin());
+
+   REQUIRE(iter->m_id == 3);
+   REQUIRE(s_destroyCount == 1);
+
+   CsPointer::CsIntrusivePointer<Job> last = list.take(list.front());
+
+   REQUIRE(list.empty() == true);
+   REQUIRE(last->m_id == 3);
+   REQUIRE(last.use_count() == 1);
+
+   list.push_back(last);
+   list.push_back(ptr);
+   list.pop_back();
+   list.clear();
+
+   REQUIRE(list.empty() == true);
+   REQUIRE(last.use_count() == 1);
+   REQUIRE(ptr.use_count() == 1);
+}
+
+TEST_CASE("CsIntrusiveList tags", "[cs_intrusive_list]")
+{
+   s_destroyCount = 0;
+
+   {
+      JobList allJobs;
+      RunJobList runJobs;
+
+      for (int i = 0; i < 4; ++i) {
+         CsPointer::CsIntrusivePointer<Job> ptr = CsPointer::make_intrusive<Job>(i);
+         allJobs.push_back(ptr);
+
+         if (i % 2 == 0) {
+            runJobs.push_back(ptr);
+         }
+      }
+
+      REQUIRE(allJobs.size() == 4);
+      REQUIRE(runJobs.size() == 2);
+
+      Job &job = runJobs.front();
+      runJobs.erase(job);
+
+      REQUIRE(runJobs.size() == 1);
+      REQUIRE(list_ids(allJobs) == std::vector<int>{0, 1, 2, 3});
+      REQUIRE(allJobs.iterator_to(job)->m_id == 0);
+   }
+
+   REQUIRE(s_destroyCount == 4);
+}
+
+TEST_CASE("CsIntrusiveList move", "[cs_intrusive_list]")
+{
+   s_destroyCount = 0;
+
+   JobList list1;
+   list1.push_back(CsPointer::make_intrusive<Job>(1));
+   list1.push_back(CsPointer::make_intrusive<Job>(2));
+
+   JobList list2 = std::move(list1);
+
+   REQUIRE(list1.empty() == true);
+   REQUIRE(list_ids(list2) == std::vector<int>{1, 2});
+
+   JobList list3;
+   list3.push_back(CsPointer::make_intrusive<Job>(3));
+
+   swap(list2, list3);
+
+   REQUIRE(list_ids(list2) == std::vector<int>{3});
+   REQUIRE(list_ids(list3) == std::vector<int>{1, 2});
+
+   list2 = std::move(list3);
+
+   REQUIRE(s_destroyCount == 1);
+   REQUIRE(list_ids(list2) == std::vector<int>{1, 2});
+   REQUIRE(list3.empty() == true);
+}
@@ -20,6 +20,12 @@
 
 #include <cs_catch2.h>
 
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
 class Fruit : public CsPointer::CsIntrusiveBase
 {
  public:
@@ -106,6 +112,42 @@ TEST_CASE("CsIntrusivePointer cast", "[cs_intrusivepointer]")
    REQUIRE(ptr1 == ptr4);
 }
 
+TEST_CASE("CsIntrusivePointer cast_move", "[cs_intrusivepointer]")
+{
+   CsPointer::CsIntrusivePointer<Apple> ptr1 = CsPointer::make_intrusive<Apple>();
+   Apple *rawPtr = ptr1.get();
+
+   //
+   CsPointer::CsIntrusivePointer<Fruit> ptr2 = CsPointer::static_pointer_cast<Fruit>(std::move(ptr1));
+
+   REQUIRE(ptr1 == nullptr);
+   REQUIRE(ptr2.get() == rawPtr);
+   REQUIRE(ptr2.use_count() == 1);
+
+   //
+   CsPointer::CsIntrusivePointer<Apple> ptr3 = CsPointer::dynamic_pointer_cast<Apple>(std::move(ptr2));
+
+   REQUIRE(ptr2 == nullptr);
+   REQUIRE(ptr3.get() == rawPtr);
+   REQUIRE(ptr3.use_count() == 1);
+
+   //
+   CsPointer::CsIntrusivePointer<const Apple> ptr4 = ptr3;
+   CsPointer::CsIntrusivePointer<Apple> ptr5 = CsPointer::const_pointer_cast<Apple>(std::move(ptr4));
+
+   REQUIRE(ptr4 == nullptr);
+   REQUIRE(ptr5 == ptr3);
+   REQUIRE(ptr3.use_count() == 2);
+
+   // failed cast leaves the source unchanged
+   CsPointer::CsIntrusivePointer<Fruit> ptr6 = CsPointer::make_intrusive<Fruit>();
+   CsPointer::CsIntrusivePointer<Apple> ptr7 = CsPointer::dynamic_pointer_cast<Apple>(std::move(ptr6));
+
+   REQUIRE(ptr7 == nullptr);
+   REQUIRE(ptr6 != nullptr);
+   REQUIRE(ptr6.use_count() == 1);
+}
+
 TEST_CASE("CsIntrusivePointer conversion", "[cs_intrusivepointer]")
 {
    REQUIRE(std::is_constructible_v<CsPointer::CsIntrusivePointer<const Fruit>,
@@ -417,6 +459,608 @@ TEST_CASE("CsIntrusivePointer swap", "[cs_intrusivepointer]")
    REQUIRE(ptr2->getTag() == "fruit");
 }
 
+TEST_CASE("CsIntrusivePointer policy", "[cs_intrusivepointer]")
+{
+   using RelaxedPtr = CsPointer::CsIntrusivePointer<Fruit, CsPointer::CsIntrusiveRelaxedPolicy>;
+
+   RelaxedPtr ptr1 = CsPointer::make_intrusive<Apple, CsPointer::CsIntrusiveRelaxedPolicy>("apple");
+
+   {
+      RelaxedPtr ptr2 = ptr1;
+
+      REQUIRE(ptr1.use_count() == 2);
+      REQUIRE(ptr2 == ptr1);
+
+      CsPointer::CsIntrusivePointer<Apple, CsPointer::CsIntrusiveRelaxedPolicy> ptr3 =
+            CsPointer::static_pointer_cast<Apple>(ptr2);
+
+      REQUIRE(ptr1.use_count() == 3);
+      REQUIRE(ptr3->getTag() == "apple");
+   }
+
+   REQUIRE(ptr1.use_count() == 1);
+
+   Fruit *rawPtr = ptr1.release_if();
+
+   REQUIRE(ptr1 == nullptr);
+   REQUIRE(rawPtr->getTag() == "apple");
+
+   ptr1 = rawPtr;
+
+   REQUIRE(ptr1.use_count() == 1);
+}
+
+TEST_CASE("CsIntrusivePointer adopt_detach", "[cs_intrusivepointer]")
+{
+   CsPointer::CsIntrusivePointer<Fruit> ptr1 = CsPointer::make_intrusive<Fruit>("fig");
+   CsPointer::CsIntrusivePointer<Fruit> ptr2 = ptr1;
+
+   Fruit *rawPtr = ptr2.detach();
+
+   REQUIRE(ptr2 == nullptr);
+   REQUIRE(ptr1.use_count() == 2);
+
+   CsPointer::CsIntrusivePointer<Fruit> ptr3(rawPtr, CsPointer::CsIntrusiveAdopt);
+
+   REQUIRE(ptr3 == ptr1);
+   REQUIRE(ptr1.use_count() == 2);
+
+   ptr3.reset();
+   REQUIRE(ptr1.use_count() == 1);
+
+   // other policies
+   using RelaxedPtr = CsPointer::CsIntrusivePointer<Apple, CsPointer::CsIntrusiveRelaxedPolicy>;
+
+   RelaxedPtr ptr4 = CsPointer::make_intrusive<Apple, CsPointer::CsIntrusiveRelaxedPolicy>("apple");
+   RelaxedPtr ptr5;
+
+   ptr5.reset(ptr4.detach(), CsPointer::CsIntrusiveAdopt);
+
+   REQUIRE(ptr4 == nullptr);
+   REQUIRE(ptr5.use_count() == 1);
+   REQUIRE(ptr5->getTag() == "apple");
+}
+
+class Grain : public CsPointer::CsIntrusiveBase_ST
+{
+ public:
+   Grain(std::string str)
+      : m_tag(str)
+   {
+   }
+
+   std::string getTag() {
+      return m_tag;
+   }
+
+ private:
+   std::string m_tag;
+};
+
+TEST_CASE("CsIntrusivePointer single_thread", "[cs_intrusivepointer]")
+{
+   using GrainPtr = CsPointer::CsIntrusivePointer<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>;
+
+   GrainPtr ptr1 = CsPointer::make_intrusive<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>("rice");
+   GrainPtr ptr2 = ptr1;
+
+   REQUIRE(ptr1.use_count() == 2);
+
+   ptr2 = CsPointer::make_intrusive<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>("wheat");
+
+   REQUIRE(ptr1.use_count() == 1);
+   REQUIRE(ptr2.use_count() == 1);
+   REQUIRE(ptr2->getTag() == "wheat");
+
+   // default policy is also supported
+   CsPointer::CsIntrusivePointer<Grain> ptr3 = CsPointer::make_intrusive<Grain>("oat");
+
+   REQUIRE(ptr3.use_count() == 1);
+   REQUIRE(ptr3->getTag() == "oat");
+
+   // copies are rejected regardless of the build type
+   REQUIRE(std::is_copy_constructible_v<Grain> == false);
+   REQUIRE(std::is_copy_assignable_v<Grain> == false);
+
+   // copies of the CM base start with a reference count of zero
+   struct Seed : public CsPointer::CsIntrusiveBase_ST_CM {
+   };
+
+   CsPointer::CsIntrusivePointer<Seed> ptr4 = CsPointer::make_intrusive<Seed>();
+   CsPointer::CsIntrusivePointer<Seed> ptr5 = CsPointer::make_intrusive<Seed>(*ptr4);
+
+   REQUIRE(ptr4.use_count() == 1);
+   REQUIRE(ptr5.use_count() == 1);
+}
+
+
+namespace {
+
+int s_allocCount   = 0;
+int s_deallocCount = 0;
+
+}
+
+template <typename T>
+class CountingAlloc
+{
+ public:
+   using value_type = T;
+
+   CountingAlloc() = default;
+
+   template <typename U>
+   CountingAlloc(const CountingAlloc<U> &)
+   {
+   }
+
+   T *allocate(std::size_t n) {
+      ++s_allocCount;
+      return std::allocator<T>().allocate(n);
+   }
+
+   void deallocate(T *p, std::size_t n) {
+      ++s_deallocCount;
+      std::allocator<T>().deallocate(p, n);
+   }
+
+   template <typename U>
+   bool operator==(const CountingAlloc<U> &) const {
+      return true;
+   }
+};
+
+TEST_CASE("CsIntrusivePointer batch", "[cs_intrusivepointer]")
+{
+   CsPointer::CsIntrusivePointer<Fruit> ptr1 = CsPointer::make_intrusive<Fruit>("lime");
+   CsPointer::CsIntrusivePointer<Fruit> ptr2 = CsPointer::make_intrusive<Fruit>("plum");
+
+   std::vector<CsPointer::CsIntrusivePointer<Fruit>> list1 = {ptr1, ptr2, nullptr, ptr1, ptr1};
+
+   REQUIRE(ptr1.use_count() == 4);
+
+   std::vector<CsPointer::CsIntrusivePointer<Fruit>> list2 = CsPointer::copy_intrusive(list1);
+
+   REQUIRE(list2 == list1);
+   REQUIRE(ptr1.use_count() == 7);
+   REQUIRE(ptr2.use_count() == 3);
+
+   CsPointer::release_intrusive(list1);
+
+   REQUIRE(list1.empty() == true);
+   REQUIRE(ptr1.use_count() == 4);
+   REQUIRE(ptr2.use_count() == 2);
+
+   ptr1.reset();
+   CsPointer::release_intrusive(list2);
+
+   REQUIRE(ptr2.use_count() == 1);
+
+   // single thread policy
+   using GrainPtr = CsPointer::CsIntrusivePointer<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>;
+
+   GrainPtr ptr3 = CsPointer::make_intrusive<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>("barley");
+   std::vector<GrainPtr> list3(3, ptr3);
+
+   std::vector<GrainPtr> list4 = CsPointer::copy_intrusive(list3);
+
+   REQUIRE(ptr3.use_count() == 7);
+
+   CsPointer::release_intrusive(list3);
+   CsPointer::release_intrusive(list4);
+
+   REQUIRE(ptr3.use_count() == 1);
+}
+
+class Berry : public CsPointer::CsIntrusiveBase
+{
+ public:
+   Berry(int *destroyCount)
+      : m_destroyCount(destroyCount)
+   {
+   }
+
+   ~Berry()
+   {
+      ++(*m_destroyCount);
+   }
+
+ private:
+   int *m_destroyCount;
+};
+
+TEST_CASE("CsIntrusivePointer release_range", "[cs_intrusivepointer]")
+{
+   int destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Berry> ptr1 = CsPointer::make_intrusive<Berry>(&destroyCount);
+   std::vector<CsPointer::CsIntrusivePointer<Berry>> list;
+
+   // spans several blocks, includes null and repeated targets
+   for (int i = 0; i < 200; ++i) {
+      if (i % 50 == 0) {
+         list.push_back(nullptr);
+         list.push_back(ptr1);
+      }
+
+      list.push_back(CsPointer::make_intrusive<Berry>(&destroyCount));
+   }
+
+   REQUIRE(ptr1.use_count() == 5);
+
+   CsPointer::release_intrusive_range(list.data(), list.data() + list.size());
+
+   REQUIRE(destroyCount == 200);
+   REQUIRE(ptr1.use_count() == 1);
+
+   for (const auto &item : list) {
+      REQUIRE(item == nullptr);
+   }
+
+   // empty range
+   CsPointer::release_intrusive_range(list.data(), list.data());
+
+   list.clear();
+   list.push_back(std::move(ptr1));
+
+   CsPointer::release_intrusive_range(list.data(), list.data() + list.size());
+
+   REQUIRE(destroyCount == 201);
+}
+
+// a policy whose dec_ref_count() does not report the last release
+class VoidDecPolicy
+{
+ public:
+   template <typename T>
+   static void inc_ref_count(const T *ptr) noexcept {
+      CsPointer::CsIntrusiveDefaultPolicy::inc_ref_count(ptr);
+   }
+
+   template <typename T>
+   static void dec_ref_count(const T *ptr) {
+      CsPointer::CsIntrusiveDefaultPolicy::dec_ref_count(ptr);
+   }
+
+   template <typename T>
+   static std::size_t get_ref_count(const T *ptr) noexcept {
+      return CsPointer::CsIntrusiveDefaultPolicy::get_ref_count(ptr);
+   }
+};
+
+TEST_CASE("CsIntrusivePointer release_range_void_policy", "[cs_intrusivepointer]")
+{
+   int destroyCount = 0;
+
+   std::vector<CsPointer::CsIntrusivePointer<Berry, VoidDecPolicy>> list;
+
+   for (int i = 0; i < 100; ++i) {
+      list.push_back(CsPointer::make_intrusive<Berry, VoidDecPolicy>(&destroyCount));
+   }
+
+   CsPointer::release_intrusive_range(list.data(), list.data() + list.size());
+
+   REQUIRE(destroyCount == 100);
+
+   for (const auto &item : list) {
+      REQUIRE(item == nullptr);
+   }
+}
+
+TEST_CASE("CsIntrusivePointer immortal", "[cs_intrusivepointer]")
+{
+   using ImmortalPtr = CsPointer::CsIntrusivePointer<Fruit, CsPointer::CsIntrusiveImmortalPolicy<>>;
+
+   ImmortalPtr ptr1 = CsPointer::make_intrusive<Fruit, CsPointer::CsIntrusiveImmortalPolicy<>>("quince");
+   ImmortalPtr ptr2 = ptr1;
+
+   REQUIRE(CsPointer::is_immortal(ptr1) == false);
+   REQUIRE(ptr1.use_count() == 2);
+
+   CsPointer::freeze(ptr1);
+
+   REQUIRE(CsPointer::is_immortal(ptr1) == true);
+
+   {
+      std::vector<ImmortalPtr> list(100, ptr1);
+
+      // no reference count writes
+      REQUIRE(ptr1.use_count() == 2);
+   }
+
+   ptr2.reset();
+   REQUIRE(ptr1.use_count() == 2);
+
+   Fruit *rawPtr = ptr1.get();
+   ptr1.reset();
+
+   REQUIRE(rawPtr->getTag() == "quince");
+
+   delete rawPtr;
+}
+
+TEST_CASE("CsIntrusivePointer immortal_default_policy", "[cs_intrusivepointer]")
+{
+   // a frozen object is never deleted, the default policy continues to count
+   alignas(Fruit) unsigned char buffer[sizeof(Fruit)];
+   Fruit *rawPtr = ::new (buffer) Fruit("date");
+
+   {
+      CsPointer::CsIntrusivePointer<Fruit> ptr1(rawPtr);
+      CsPointer::freeze(ptr1);
+
+      CsPointer::CsIntrusivePointer<Fruit> ptr2 = ptr1;
+
+      REQUIRE(CsPointer::is_immortal(ptr2) == true);
+      REQUIRE(ptr2.use_count() == 2);
+   }
+
+   REQUIRE(rawPtr->getTag() == "date");
+
+   rawPtr->~Fruit();
+}
+
+TEST_CASE("CsIntrusivePointer try_take_unique", "[cs_intrusivepointer]")
+{
+   CsPointer::CsIntrusivePointer<Fruit> ptr1 = CsPointer::make_intrusive<Fruit>("kiwi");
+   CsPointer::CsIntrusivePointer<Fruit> ptr2 = ptr1;
+
+   REQUIRE(ptr1.try_take_unique() == nullptr);
+   REQUIRE(ptr1 == ptr2);
+   REQUIRE(ptr1.use_count() == 2);
+
+   ptr2.reset();
+
+   Fruit *rawPtr = ptr1.try_take_unique();
+
+   REQUIRE(rawPtr != nullptr);
+   REQUIRE(ptr1 == nullptr);
+   REQUIRE(rawPtr->getTag() == "kiwi");
+
+   // caller owns the object, the count is zero
+   ptr1.reset(rawPtr);
+   REQUIRE(ptr1.use_count() == 1);
+
+   // single thread policy
+   using GrainPtr = CsPointer::CsIntrusivePointer<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>;
+
+   GrainPtr ptr3 = CsPointer::make_intrusive<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>("millet");
+   Grain *grainPtr = ptr3.try_take_unique();
+
+   REQUIRE(grainPtr != nullptr);
+   delete grainPtr;
+}
+
+class Melon : public CsPointer::CsIntrusiveBase
+{
+ public:
+   ~Melon()
+   {
+      ++s_melonCount;
+   }
+
+   static inline std::atomic<int> s_melonCount = 0;
+};
+
+TEST_CASE("CsIntrusivePointer try_take_unique_threads", "[cs_intrusivepointer]")
+{
+   for (int i = 0; i < 100; ++i) {
+      Melon::s_melonCount = 0;
+
+      CsPointer::CsIntrusivePointer<Melon> ptr = CsPointer::make_intrusive<Melon>();
+      std::vector<std::thread> threads;
+
+      for (int j = 0; j < 4; ++j) {
+         threads.emplace_back([copy = ptr] () mutable {
+            Melon *rawPtr = copy.try_take_unique();
+
+            if (rawPtr != nullptr) {
+               delete rawPtr;
+            } else {
+               copy.reset();
+            }
+         });
+      }
+
+      ptr.reset();
+
+      for (auto &item : threads) {
+         item.join();
+      }
+
+      REQUIRE(Melon::s_melonCount == 1);
+   }
+}
+
+TEST_CASE("CsIntrusivePointer allocate", "[cs_intrusivepointer]")
+{
+   s_allocCount   = 0;
+   s_deallocCount = 0;
+
+   {
+      CsPointer::CsIntrusivePointer<Fruit> ptr1 = CsPointer::allocate_intrusive<Apple>(CountingAlloc<Apple>(), "apple");
+      CsPointer::CsIntrusivePointer<Fruit> ptr2 = ptr1;
+
+      REQUIRE(s_allocCount == 1);
+      REQUIRE(ptr1.use_count() == 2);
+      REQUIRE(ptr1->getTag() == "apple");
+      REQUIRE(dynamic_cast<Apple *>(ptr1.get()) != nullptr);
+
+      ptr2.reset();
+      REQUIRE(s_deallocCount == 0);
+   }
+
+   REQUIRE(s_deallocCount == 1);
+
+   // single threaded base and policy
+   using GrainPtr = CsPointer::CsIntrusivePointer<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>;
+
+   GrainPtr ptr3 = CsPointer::allocate_intrusive<Grain, CsPointer::CsIntrusiveSingleThreadPolicy>(
+         CountingAlloc<Grain>(), "rice");
+
+   REQUIRE(s_allocCount == 2);
+
+   ptr3.reset();
+   REQUIRE(s_deallocCount == 2);
+}
+
+TEST_CASE("CsIntrusivePointer allocate_pmr", "[cs_intrusivepointer]")
+{
+   char buffer[1024];
+   std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+   CsPointer::CsIntrusivePointer<Fruit> ptr = CsPointer::allocate_intrusive<Fruit>(
+         std::pmr::polymorphic_allocator<Fruit>(&resource), "pear");
+
+   REQUIRE(static_cast<void *>(ptr.get()) >= static_cast<void *>(buffer));
+   REQUIRE(static_cast<void *>(ptr.get()) < static_cast<void *>(buffer + sizeof(buffer)));
+   REQUIRE(ptr->getTag() == "pear");
+}
+
+class Seed : public CsPointer::CsIntrusiveBaseT<Seed>
+{
+ public:
+   Seed(int value)
+      : m_value(value)
+   {
+   }
+
+   ~Seed()
+   {
+      ++s_seedCount;
+   }
+
+   int getValue() const {
+      return m_value;
+   }
+
+   static inline int s_seedCount = 0;
+
+ private:
+   int m_value;
+};
+
+TEST_CASE("CsIntrusivePointer crtp", "[cs_intrusivepointer]")
+{
+   REQUIRE(std::is_polymorphic_v<Seed> == false);
+   REQUIRE(sizeof(Seed) == sizeof(std::size_t) + sizeof(std::size_t));
+
+   Seed::s_seedCount = 0;
+
+   {
+      CsPointer::CsIntrusivePointer<Seed> ptr1 = CsPointer::make_intrusive<Seed>(17);
+      CsPointer::CsIntrusivePointer<Seed> ptr2 = ptr1;
+
+      REQUIRE(ptr1.use_count() == 2);
+      REQUIRE(ptr2->getValue() == 17);
+
+      CsPointer::CsIntrusivePointer<const Seed> ptr3 = CsPointer::static_pointer_cast<const Seed>(ptr1);
+      CsPointer::CsIntrusivePointer<Seed> ptr4 = CsPointer::const_pointer_cast<Seed>(ptr3);
+
+      REQUIRE(ptr1.use_count() == 4);
+      REQUIRE(ptr4 == ptr1);
+
+      CsPointer::CsIntrusivePointer<Seed, CsPointer::CsIntrusiveRelaxedPolicy> ptr5 =
+            CsPointer::make_intrusive<Seed, CsPointer::CsIntrusiveRelaxedPolicy>(42);
+
+      REQUIRE(ptr5->getValue() == 42);
+   }
+
+   REQUIRE(Seed::s_seedCount == 2);
+}
+
+class Pip : public CsPointer::CsIntrusiveBaseT<Pip, std::uint32_t>
+{
+ public:
+   std::uint32_t m_value = 0;
+};
+
+class Speck : public CsPointer::CsIntrusiveBaseT<Speck, std::uint16_t, CsPointer::CsIntrusiveOverflow::Saturate>
+{
+ public:
+   static inline int s_speckCount = 0;
+
+   ~Speck()
+   {
+      ++s_speckCount;
+   }
+};
+
+TEST_CASE("CsIntrusivePointer crtp_compact", "[cs_intrusivepointer]")
+{
+   REQUIRE(sizeof(Pip) == 8);
+   REQUIRE(sizeof(Speck) == 2);
+
+   CsPointer::CsIntrusivePointer<Pip> ptr1 = CsPointer::make_intrusive<Pip>();
+   CsPointer::CsIntrusivePointer<Pip> ptr2 = ptr1;
+
+   REQUIRE(ptr1.use_count() == 2);
+
+   Speck::s_speckCount = 0;
+
+   // saturated object is never deleted
+   alignas(Speck) unsigned char buffer[sizeof(Speck)];
+
+   {
+      CsPointer::CsIntrusivePointer<Speck> ptr3(::new (buffer) Speck);
+
+      std::vector<CsPointer::CsIntrusivePointer<Speck>> list(70000, ptr3);
+
+      // count is pinned at the maximum and the object is immortal
+      REQUIRE(CsPointer::is_immortal(ptr3) == true);
+      REQUIRE(ptr3.use_count() == 32767);
+   }
+
+   REQUIRE(Speck::s_speckCount == 0);
+}
+
+class Grit : public CsPointer::CsIntrusiveBaseT<Grit, std::uint16_t>
+{
+ public:
+   static inline int s_gritCount = 0;
+
+   ~Grit()
+   {
+      ++s_gritCount;
+   }
+};
+
+TEST_CASE("CsIntrusivePointer crtp_compact_flag", "[cs_intrusivepointer]")
+{
+   using ImmortalPolicy = CsPointer::CsIntrusiveImmortalPolicy<>;
+
+   Grit::s_gritCount = 0;
+
+   {
+      // largest count below the immortal flag
+      CsPointer::CsIntrusivePointer<Grit, ImmortalPolicy> ptr = CsPointer::make_intrusive<Grit, ImmortalPolicy>();
+      std::vector<CsPointer::CsIntrusivePointer<Grit, ImmortalPolicy>> list(32766, ptr);
+
+      REQUIRE(ptr.use_count() == 32767);
+      REQUIRE(CsPointer::is_immortal(ptr) == false);
+
+      list.clear();
+
+      REQUIRE(ptr.use_count() == 1);
+   }
+
+   REQUIRE(Grit::s_gritCount == 1);
+
+   // frozen object keeps counting below the flag and is never deleted
+   alignas(Grit) unsigned char buffer[sizeof(Grit)];
+
+   {
+      CsPointer::CsIntrusivePointer<Grit> ptr(::new (buffer) Grit);
+      CsPointer::freeze(ptr);
+
+      std::vector<CsPointer::CsIntrusivePointer<Grit>> list(1000, ptr);
+
+      REQUIRE(ptr.use_count() == 1001);
+      REQUIRE(CsPointer::is_immortal(ptr) == true);
+   }
+
+   REQUIRE(Grit::s_gritCount == 1);
+}
 
 // part 2
 
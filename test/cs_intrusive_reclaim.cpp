@@ -0,0 +1,200 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_reclaim.h>
+
+#include <cs_catch2.h>
+
+#include <atomic>
+#include <vector>
+
+namespace {
+
+int s_destroyCount = 0;
+
+}
+
+class Config : public CsPointer::CsIntrusiveBase
+{
+ public:
+   Config(int value)
+      : m_value(value)
+   {
+   }
+
+   ~Config()
+   {
+      ++s_destroyCount;
+   }
+
+   int value() const {
+      return m_value;
+   }
+
+ private:
+   int m_value;
+};
+
+TEST_CASE("CsIntrusiveReclaim epoch", "[cs_intrusive_reclaim]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsReclaimDomain domain;
+   std::atomic<Config *> slot = new Config(1);
+
+   {
+      CsPointer::CsEpochGuard guard(domain);
+      Config *ptr = guard.protect(slot);
+
+      domain.retire(slot.exchange(nullptr));
+
+      for (int i = 0; i < 4; ++i) {
+         domain.reclaim();
+      }
+
+      REQUIRE(s_destroyCount == 0);
+      REQUIRE(ptr->value() == 1);
+   }
+
+   for (int i = 0; i < 4; ++i) {
+      domain.reclaim();
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveReclaim hazard", "[cs_intrusive_reclaim]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsReclaimDomain domain;
+   std::atomic<Config *> slot = new Config(2);
+
+   CsPointer::CsHazardPointer hazard(domain);
+   Config *ptr = hazard.protect(slot);
+
+   domain.retire(slot.exchange(nullptr));
+
+   for (int i = 0; i < 4; ++i) {
+      domain.reclaim();
+   }
+
+   REQUIRE(s_destroyCount == 0);
+   REQUIRE(ptr->value() == 2);
+
+   hazard.reset();
+
+   for (int i = 0; i < 4; ++i) {
+      domain.reclaim();
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveReclaim policy", "[cs_intrusive_reclaim]")
+{
+   using ConfigPtr = CsPointer::CsIntrusivePointer<Config, CsPointer::CsIntrusiveReclaimPolicy<>>;
+
+   s_destroyCount = 0;
+
+   ConfigPtr owner = CsPointer::make_intrusive<Config, CsPointer::CsIntrusiveReclaimPolicy<>>(3);
+   std::atomic<Config *> slot = owner.get();
+
+   CsPointer::CsHazardPointer hazard;
+   Config *ptr = hazard.protect(slot);
+
+   // writer unpublishes and drops the last reference
+   slot.store(nullptr);
+   owner.reset();
+
+   CsPointer::CsReclaimDomain::global().reclaim();
+
+   REQUIRE(s_destroyCount == 0);
+   REQUIRE(ptr->value() == 3);
+
+   hazard.reset();
+
+   for (int i = 0; i < 4; ++i) {
+      CsPointer::CsReclaimDomain::global().reclaim();
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveReclaim immortal_release_range", "[cs_intrusive_reclaim]")
+{
+   using ImmortalPolicy = CsPointer::CsIntrusiveImmortalPolicy<CsPointer::CsIntrusiveReclaimPolicy<>>;
+   using ConfigPtr      = CsPointer::CsIntrusivePointer<Config, ImmortalPolicy>;
+
+   s_destroyCount = 0;
+
+   std::vector<ConfigPtr> list;
+   list.push_back(CsPointer::make_intrusive<Config, ImmortalPolicy>(4));
+
+   std::atomic<Config *> slot = list[0].get();
+
+   CsPointer::CsHazardPointer hazard;
+   Config *ptr = hazard.protect(slot);
+
+   // retired to the domain, not deleted while the reader holds the hazard pointer
+   slot.store(nullptr);
+   CsPointer::release_intrusive_range(list.data(), list.data() + list.size());
+
+   CsPointer::CsReclaimDomain::global().reclaim();
+
+   REQUIRE(s_destroyCount == 0);
+   REQUIRE(ptr->value() == 4);
+
+   hazard.reset();
+
+   for (int i = 0; i < 4; ++i) {
+      CsPointer::CsReclaimDomain::global().reclaim();
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveReclaim thread_record", "[cs_intrusive_reclaim]")
+{
+   CsPointer::CsReclaimDomain &domain = CsPointer::CsReclaimDomain::global();
+
+   CsPointer::CsReclaimDomain::Record *record1 = domain.acquire_thread_record();
+   domain.release_thread_record(record1);
+
+   // the record is kept by this thread
+   CsPointer::CsReclaimDomain::Record *record2 = domain.acquire_thread_record();
+
+   REQUIRE(record2 == record1);
+   REQUIRE(record2->m_hazard.load() == nullptr);
+
+   // nested reader on the same thread
+   CsPointer::CsReclaimDomain::Record *record3 = domain.acquire_thread_record();
+
+   REQUIRE(record3 != record2);
+
+   domain.release_thread_record(record3);
+   domain.release_thread_record(record2);
+
+   // records of other domains are not kept
+   CsPointer::CsReclaimDomain other;
+
+   CsPointer::CsReclaimDomain::Record *record4 = other.acquire_thread_record();
+   other.release_thread_record(record4);
+
+   REQUIRE(record4->m_inUse.load() == false);
+}
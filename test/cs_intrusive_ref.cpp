@@ -0,0 +1,98 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_ref.h>
+
+#include <cs_catch2.h>
+
+#include <type_traits>
+
+class Polygon : public CsPointer::CsIntrusiveBase
+{
+ public:
+   int m_sides = 0;
+};
+
+class Hexagon : public Polygon
+{
+ public:
+   Hexagon()
+   {
+      m_sides = 6;
+   }
+};
+
+namespace {
+
+int count_sides(CsPointer::CsIntrusiveRef<const Polygon> shape)
+{
+   return shape->m_sides;
+}
+
+}
+
+TEST_CASE("CsIntrusiveRef traits", "[cs_intrusive_ref]")
+{
+   REQUIRE(std::is_trivially_copyable_v<CsPointer::CsIntrusiveRef<Polygon>> == true);
+   REQUIRE(sizeof(CsPointer::CsIntrusiveRef<Polygon>) == sizeof(Polygon *));
+
+   REQUIRE(std::is_convertible_v<CsPointer::CsIntrusivePointer<Hexagon>, CsPointer::CsIntrusiveRef<Polygon>> == true);
+   REQUIRE(std::is_convertible_v<CsPointer::CsIntrusiveRef<Hexagon>, CsPointer::CsIntrusiveRef<const Polygon>> == true);
+   REQUIRE(std::is_convertible_v<Polygon *, CsPointer::CsIntrusiveRef<Polygon>> == false);
+   REQUIRE(std::is_constructible_v<CsPointer::CsIntrusiveRef<Polygon>, Polygon *> == true);
+}
+
+TEST_CASE("CsIntrusiveRef borrow", "[cs_intrusive_ref]")
+{
+   CsPointer::CsIntrusivePointer<Hexagon> ptr = CsPointer::make_intrusive<Hexagon>();
+
+   REQUIRE(count_sides(ptr) == 6);
+   REQUIRE(count_sides(CsPointer::CsIntrusiveRef<Hexagon>(ptr.get())) == 6);
+   REQUIRE(ptr.use_count() == 1);
+
+   CsPointer::CsIntrusiveRef<Polygon> ref = ptr;
+
+   REQUIRE(ref == ptr);
+   REQUIRE(ptr == ref);
+   REQUIRE(ref != nullptr);
+   REQUIRE(ref.get() == ptr.get());
+   REQUIRE((*ref).m_sides == 6);
+   REQUIRE(ptr.use_count() == 1);
+
+   CsPointer::CsIntrusiveRef<Polygon> empty;
+
+   REQUIRE(empty == nullptr);
+   REQUIRE(! empty);
+   REQUIRE(empty != ref);
+}
+
+TEST_CASE("CsIntrusiveRef promote", "[cs_intrusive_ref]")
+{
+   CsPointer::CsIntrusivePointer<Hexagon> ptr1 = CsPointer::make_intrusive<Hexagon>();
+   CsPointer::CsIntrusiveRef<Polygon> ref = ptr1;
+
+   CsPointer::CsIntrusivePointer<Polygon> ptr2 = ref.toIntrusivePointer();
+
+   REQUIRE(ptr2 == ptr1);
+   REQUIRE(ptr1.use_count() == 2);
+
+   ptr1.reset();
+
+   REQUIRE(ref->m_sides == 6);
+   REQUIRE(ptr2.use_count() == 1);
+}
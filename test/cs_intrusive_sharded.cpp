@@ -0,0 +1,147 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_sharded.h>
+
+#include <cs_catch2.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<int> s_destroyCount = 0;
+
+}
+
+class RouteTable : public CsPointer::CsIntrusiveBase_Sharded
+{
+ public:
+   RouteTable(int value)
+      : m_value(value)
+   {
+   }
+
+   ~RouteTable()
+   {
+      ++s_destroyCount;
+   }
+
+   int value() const {
+      return m_value;
+   }
+
+ private:
+   int m_value;
+};
+
+using ShardedPtr = CsPointer::CsIntrusivePointer<RouteTable, CsPointer::CsIntrusiveShardedPolicy>;
+
+TEST_CASE("CsIntrusiveSharded central", "[cs_intrusive_sharded]")
+{
+   s_destroyCount = 0;
+
+   {
+      ShardedPtr ptr1 = CsPointer::make_intrusive<RouteTable, CsPointer::CsIntrusiveShardedPolicy>(5);
+      ShardedPtr ptr2 = ptr1;
+
+      REQUIRE(ptr1.use_count() == 2);
+
+      ptr2.reset();
+
+      REQUIRE(ptr1.use_count() == 1);
+      REQUIRE(s_destroyCount == 0);
+   }
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveSharded collapse", "[cs_intrusive_sharded]")
+{
+   s_destroyCount = 0;
+
+   ShardedPtr ptr = CsPointer::make_intrusive<RouteTable, CsPointer::CsIntrusiveShardedPolicy>(7);
+
+   REQUIRE(CsPointer::CsIntrusiveShardedPolicy::enable_sharding(ptr.get()) == true);
+   REQUIRE(CsPointer::CsIntrusiveShardedPolicy::enable_sharding(ptr.get()) == false);
+
+   ShardedPtr copy = ptr;
+
+   REQUIRE(ptr.use_count() == 2);
+   REQUIRE(copy.try_take_unique() == nullptr);
+
+   // reference acquired on this thread is released on another thread
+   std::thread worker([tmp = std::move(copy)] () mutable {
+      tmp.reset();
+   });
+
+   worker.join();
+
+   REQUIRE(ptr.use_count() == 1);
+
+   CsPointer::CsIntrusiveShardedPolicy::collapse(ptr.get());
+
+   REQUIRE(ptr.use_count() == 1);
+   REQUIRE(s_destroyCount == 0);
+   REQUIRE(CsPointer::CsIntrusiveShardedPolicy::enable_sharding(ptr.get()) == false);
+
+   ptr.reset();
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveSharded threads", "[cs_intrusive_sharded]")
+{
+   s_destroyCount = 0;
+
+   ShardedPtr ptr = CsPointer::make_intrusive<RouteTable, CsPointer::CsIntrusiveShardedPolicy>(9);
+   CsPointer::CsIntrusiveShardedPolicy::enable_sharding(ptr.get());
+
+   std::atomic<int> badValue = 0;
+   std::vector<std::thread> threads;
+
+   for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([copy = ptr, &badValue] () {
+         std::vector<ShardedPtr> list;
+
+         for (int j = 0; j < 5000; ++j) {
+            list.push_back(copy);
+
+            if (list.size() == 16) {
+               list.clear();
+            }
+
+            if (copy->value() != 9) {
+               ++badValue;
+            }
+         }
+      });
+   }
+
+   // publisher releases the object while readers are still running
+   CsPointer::CsIntrusiveShardedPolicy::collapse(ptr.get());
+   ptr.reset();
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   REQUIRE(badValue == 0);
+   REQUIRE(s_destroyCount == 1);
+}
@@ -0,0 +1,223 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_biased.h>
+#include <cs_intrusive_stats.h>
+
+#include <cs_catch2.h>
+
+#include <thread>
+#include <vector>
+
+// checks every operation for a handoff so the counts are exact
+using StatsPolicy = CsPointer::CsIntrusiveStatsPolicy<CsPointer::CsIntrusiveDefaultPolicy, 1>;
+
+class Sensor : public CsPointer::CsIntrusiveBase
+{
+};
+
+class Gauge : public CsPointer::CsIntrusiveBase
+{
+};
+
+namespace {
+
+template <typename T>
+CsPointer::CsIntrusiveStats::TypeStats find_stats()
+{
+   for (const auto &item : CsPointer::CsIntrusiveStats::snapshot()) {
+      if (item.m_name == CsPointer::cs_type_name<T>::name()) {
+         return item;
+      }
+   }
+
+   return CsPointer::CsIntrusiveStats::TypeStats();
+}
+
+}
+
+TEST_CASE("CsIntrusiveStats counts", "[cs_intrusive_stats]")
+{
+   CsPointer::CsIntrusiveStats::TypeStats before = find_stats<Sensor>();
+
+   {
+      CsPointer::CsIntrusivePointer<Sensor, StatsPolicy> ptr1 = CsPointer::make_intrusive<Sensor, StatsPolicy>();
+
+      CsPointer::CsIntrusivePointer<Sensor, StatsPolicy> ptr2 = ptr1;
+      CsPointer::CsIntrusivePointer<Sensor, StatsPolicy> ptr3 = ptr1;
+   }
+
+   CsPointer::CsIntrusiveStats::TypeStats stats = find_stats<Sensor>();
+
+   REQUIRE(stats.m_incCount - before.m_incCount == 3);
+   REQUIRE(stats.m_decCount - before.m_decCount == 3);
+   REQUIRE(stats.m_handoffCount - before.m_handoffCount == 0);
+   REQUIRE(stats.m_peakCount >= 3);
+}
+
+TEST_CASE("CsIntrusiveStats handoff", "[cs_intrusive_stats]")
+{
+   CsPointer::CsIntrusiveStats::TypeStats before = find_stats<Gauge>();
+
+   CsPointer::CsIntrusivePointer<Gauge, StatsPolicy> ptr = CsPointer::make_intrusive<Gauge, StatsPolicy>();
+
+   std::thread thread([&ptr] () {
+      CsPointer::CsIntrusivePointer<Gauge, StatsPolicy> tmp = ptr;
+   });
+
+   thread.join();
+
+   CsPointer::CsIntrusiveStats::TypeStats stats = find_stats<Gauge>();
+
+   REQUIRE(stats.m_incCount - before.m_incCount == 2);
+   REQUIRE(stats.m_decCount - before.m_decCount == 1);
+   REQUIRE(stats.m_handoffCount - before.m_handoffCount == 1);
+
+   ptr.reset();
+
+   stats = find_stats<Gauge>();
+
+   REQUIRE(stats.m_decCount - before.m_decCount == 2);
+   REQUIRE(stats.m_handoffCount - before.m_handoffCount == 2);
+}
+
+class Meter : public CsPointer::CsIntrusiveBase
+{
+};
+
+TEST_CASE("CsIntrusiveStats handoff_sample", "[cs_intrusive_stats]")
+{
+   using SampledPolicy = CsPointer::CsIntrusiveStatsPolicy<CsPointer::CsIntrusiveDefaultPolicy, 4>;
+   using MeterPtr      = CsPointer::CsIntrusivePointer<Meter, SampledPolicy>;
+
+   CsPointer::CsIntrusiveStats::TypeStats before = find_stats<Meter>();
+
+   // the fourth increment on this thread is checked and records the owner
+   MeterPtr ptr = CsPointer::make_intrusive<Meter, SampledPolicy>();
+   std::vector<MeterPtr> list(3, ptr);
+
+   std::thread thread([&ptr] () {
+      // the fourth increment on the second thread is checked and finds the handoff
+      std::vector<MeterPtr> copies(4, ptr);
+   });
+
+   thread.join();
+
+   CsPointer::CsIntrusiveStats::TypeStats stats = find_stats<Meter>();
+
+   REQUIRE(stats.m_incCount - before.m_incCount == 8);
+   REQUIRE(stats.m_decCount - before.m_decCount == 4);
+   REQUIRE(stats.m_handoffCount - before.m_handoffCount == 4);
+}
+
+class Dial : public CsPointer::CsIntrusiveBase
+{
+};
+
+TEST_CASE("CsIntrusiveStats thread_exit", "[cs_intrusive_stats]")
+{
+   CsPointer::CsIntrusiveStats::TypeStats before = find_stats<Dial>();
+
+   for (int i = 0; i < 10; ++i) {
+      std::thread thread([] () {
+         CsPointer::CsIntrusivePointer<Dial, StatsPolicy> ptr = CsPointer::make_intrusive<Dial, StatsPolicy>();
+      });
+
+      thread.join();
+   }
+
+   CsPointer::CsIntrusiveStats::TypeStats stats = find_stats<Dial>();
+
+   // each thread reused the slot of the previous one, the counters were kept
+   REQUIRE(CsPointer::CsIntrusiveStats::record<Dial>().slot_count() == 1);
+   REQUIRE(stats.m_incCount - before.m_incCount == 10);
+   REQUIRE(stats.m_decCount - before.m_decCount == 10);
+}
+
+TEST_CASE("CsIntrusiveStats report", "[cs_intrusive_stats]")
+{
+   CsPointer::CsIntrusivePointer<Sensor, StatsPolicy> ptr = CsPointer::make_intrusive<Sensor, StatsPolicy>();
+
+   auto snapshot = CsPointer::CsIntrusiveStats::snapshot();
+
+   std::string json = CsPointer::CsIntrusiveStats::to_json(snapshot);
+   std::string text = CsPointer::CsIntrusiveStats::to_text(snapshot);
+
+   REQUIRE(json.front() == '[');
+   REQUIRE(json.back() == ']');
+   REQUIRE(json.find(std::string("\"type\":\"") + CsPointer::cs_type_name<Sensor>::name() + "\"") != std::string::npos);
+
+   REQUIRE(text.find(CsPointer::cs_type_name<Sensor>::name()) != std::string::npos);
+}
+
+class Valve : public CsPointer::CsIntrusiveBase
+{
+};
+
+template <>
+struct CsPointer::cs_type_name<Valve> {
+   static const char *name() {
+      return "Valve";
+   }
+};
+
+TEST_CASE("CsIntrusiveStats custom_name", "[cs_intrusive_stats]")
+{
+   CsPointer::CsIntrusiveStats::TypeStats before = find_stats<Valve>();
+
+   {
+      CsPointer::CsIntrusivePointer<Valve, StatsPolicy> ptr = CsPointer::make_intrusive<Valve, StatsPolicy>();
+   }
+
+   CsPointer::CsIntrusiveStats::TypeStats stats = find_stats<Valve>();
+
+   REQUIRE(stats.m_name == "Valve");
+   REQUIRE(stats.m_decCount - before.m_decCount == 1);
+}
+
+class Beacon : public CsPointer::CsIntrusiveBase_Biased
+{
+};
+
+namespace {
+
+template <typename Policy, typename T>
+constexpr bool has_try_take_unique = requires (const T *p) { Policy::try_take_unique(p); };
+
+template <typename Policy, typename T>
+constexpr bool has_try_inc_ref_count = requires (const T *p) { Policy::try_inc_ref_count(p); };
+
+}
+
+TEST_CASE("CsIntrusiveStats optional_hooks", "[cs_intrusive_stats]")
+{
+   using BiasedStatsPolicy = CsPointer::CsIntrusiveStatsPolicy<CsPointer::CsIntrusiveBiasedPolicy>;
+
+   // forwarders exist only when the wrapped policy provides the hook
+   REQUIRE(has_try_take_unique<BiasedStatsPolicy, Beacon> == false);
+   REQUIRE(has_try_inc_ref_count<BiasedStatsPolicy, Beacon> == false);
+   REQUIRE(has_try_take_unique<StatsPolicy, Sensor> == true);
+
+   CsPointer::CsIntrusivePointer<Beacon, BiasedStatsPolicy> ptr = CsPointer::make_intrusive<Beacon, BiasedStatsPolicy>();
+   Beacon *rawPtr = ptr.get();
+
+   REQUIRE(ptr.release_if() == rawPtr);
+   REQUIRE(ptr == nullptr);
+
+   delete rawPtr;
+}
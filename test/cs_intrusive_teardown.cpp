@@ -0,0 +1,124 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_teardown.h>
+#include <cs_nodemanager.h>
+
+#include <cs_catch2.h>
+
+namespace {
+
+int s_destroyCount = 0;
+
+constexpr int ChainLength = 1000000;
+constexpr int TreeDepth   = 200000;
+
+}
+
+using IterativePolicy = CsPointer::CsIntrusiveIterativePolicy<>;
+
+class Link : public CsPointer::CsIntrusiveBase
+{
+ public:
+   ~Link()
+   {
+      ++s_destroyCount;
+   }
+
+   CsPointer::CsIntrusivePointer<Link, IterativePolicy> m_next;
+};
+
+class Level : public CsPointer::CsNodeManager<Level>, public CsPointer::CsIntrusiveBase
+{
+ public:
+   ~Level()
+   {
+      ++s_destroyCount;
+   }
+};
+
+TEST_CASE("CsIntrusiveTeardown chain", "[cs_intrusive_teardown]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Link, IterativePolicy> head = CsPointer::make_intrusive<Link, IterativePolicy>();
+   Link *tail = head.get();
+
+   for (int i = 1; i < ChainLength; ++i) {
+      tail->m_next = CsPointer::make_intrusive<Link, IterativePolicy>();
+      tail = tail->m_next.get();
+   }
+
+   head.reset();
+
+   REQUIRE(s_destroyCount == ChainLength);
+}
+
+TEST_CASE("CsIntrusiveTeardown shared_chain", "[cs_intrusive_teardown]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Link, IterativePolicy> head = CsPointer::make_intrusive<Link, IterativePolicy>();
+   head->m_next = CsPointer::make_intrusive<Link, IterativePolicy>();
+   head->m_next->m_next = CsPointer::make_intrusive<Link, IterativePolicy>();
+
+   CsPointer::CsIntrusivePointer<Link, IterativePolicy> middle = head->m_next;
+
+   head.reset();
+
+   REQUIRE(s_destroyCount == 1);
+   REQUIRE(middle.use_count() == 1);
+
+   middle.reset();
+
+   REQUIRE(s_destroyCount == 3);
+}
+
+TEST_CASE("CsIntrusiveTeardown node_manager", "[cs_intrusive_teardown]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Level> root = CsPointer::make_intrusive<Level>();
+   CsPointer::CsIntrusivePointer<Level> shared;
+
+   Level *parent = root.get();
+
+   for (int i = 0; i < TreeDepth; ++i) {
+      CsPointer::CsIntrusivePointer<Level> child = CsPointer::make_intrusive<Level>();
+      parent->add_child(child);
+
+      if (i == TreeDepth / 2) {
+         shared = child;
+      }
+
+      parent = child.get();
+   }
+
+   root->clear();
+
+   // subtree below the shared node is kept alive
+   REQUIRE(s_destroyCount == TreeDepth / 2);
+   REQUIRE(shared.use_count() == 1);
+   REQUIRE(shared->children().size() == 1);
+
+   shared.reset();
+   REQUIRE(s_destroyCount == TreeDepth);
+
+   root.reset();
+   REQUIRE(s_destroyCount == TreeDepth + 1);
+}
@@ -0,0 +1,259 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_weak_pointer.h>
+
+#include <cs_catch2.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int s_destroyCount = 0;
+
+}
+
+class Parent : public CsPointer::CsIntrusiveBase_Weak
+{
+ public:
+   Parent(std::string str)
+      : m_tag(str)
+   {
+   }
+
+   ~Parent()
+   {
+      ++s_destroyCount;
+   }
+
+   std::string getTag() {
+      return m_tag;
+   }
+
+ private:
+   std::string m_tag;
+};
+
+class Child : public Parent
+{
+ public:
+   Child(std::string str)
+      : Parent(str)
+   {
+   }
+};
+
+TEST_CASE("CsIntrusiveWeakPointer traits", "[cs_intrusive_weakpointer]")
+{
+   REQUIRE(std::is_copy_constructible_v<CsPointer::CsIntrusiveWeakPointer<Parent>> == true);
+   REQUIRE(std::is_move_constructible_v<CsPointer::CsIntrusiveWeakPointer<Parent>> == true);
+
+   REQUIRE(std::is_copy_assignable_v<CsPointer::CsIntrusiveWeakPointer<Parent>> == true);
+   REQUIRE(std::is_move_assignable_v<CsPointer::CsIntrusiveWeakPointer<Parent>> == true);
+
+   REQUIRE(sizeof(CsPointer::CsIntrusiveWeakPointer<Parent>) == sizeof(void *));
+}
+
+TEST_CASE("CsIntrusiveWeakPointer empty", "[cs_intrusive_weakpointer]")
+{
+   CsPointer::CsIntrusiveWeakPointer<Parent> ptr;
+
+   REQUIRE(ptr.expired() == true);
+   REQUIRE(ptr == nullptr);
+   REQUIRE(ptr.lock() == nullptr);
+   REQUIRE(ptr.use_count() == 0);
+}
+
+TEST_CASE("CsIntrusiveWeakPointer lock", "[cs_intrusive_weakpointer]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Parent> ptr1 = CsPointer::make_intrusive<Parent>("parent");
+   CsPointer::CsIntrusivePointer<Parent> ptr2 = ptr1;
+
+   REQUIRE(ptr1.use_count() == 2);
+
+   CsPointer::CsIntrusiveWeakPointer<Parent> weak = ptr1;
+
+   REQUIRE(weak.expired() == false);
+   REQUIRE(weak.use_count() == 2);
+   REQUIRE(ptr1.use_count() == 2);
+
+   {
+      CsPointer::CsIntrusivePointer<Parent> ptr3 = weak.lock();
+
+      REQUIRE(ptr3 == ptr1);
+      REQUIRE(ptr3->getTag() == "parent");
+      REQUIRE(ptr1.use_count() == 3);
+   }
+
+   ptr1.reset();
+   ptr2.reset();
+
+   REQUIRE(s_destroyCount == 1);
+   REQUIRE(weak.expired() == true);
+   REQUIRE(weak.lock() == nullptr);
+}
+
+TEST_CASE("CsIntrusiveWeakPointer conversion", "[cs_intrusive_weakpointer]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusiveWeakPointer<Parent> weak;
+
+   {
+      CsPointer::CsIntrusivePointer<Child> ptr = CsPointer::make_intrusive<Child>("child");
+      weak = ptr;
+
+      CsPointer::CsIntrusiveWeakPointer<Parent> copy = weak;
+
+      REQUIRE(copy == weak);
+      REQUIRE(copy.lock()->getTag() == "child");
+   }
+
+   REQUIRE(s_destroyCount == 1);
+   REQUIRE(weak.expired() == true);
+}
+
+TEST_CASE("CsIntrusiveWeakPointer order_policy", "[cs_intrusive_weakpointer]")
+{
+   using RelaxedPolicy = CsPointer::CsIntrusiveRelaxedPolicy;
+
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Parent, RelaxedPolicy> ptr1 = CsPointer::make_intrusive<Parent, RelaxedPolicy>("relaxed");
+   CsPointer::CsIntrusivePointer<Parent, RelaxedPolicy> ptr2 = ptr1;
+
+   ptr2.reset();
+
+   REQUIRE(ptr1.use_count() == 1);
+   REQUIRE(s_destroyCount == 0);
+
+   // count moves to the weak block
+   CsPointer::CsIntrusiveWeakPointer<Parent, RelaxedPolicy> weak = ptr1;
+
+   ptr2 = weak.lock();
+   REQUIRE(ptr1.use_count() == 2);
+
+   ptr2.reset();
+   ptr1.reset();
+
+   REQUIRE(s_destroyCount == 1);
+   REQUIRE(weak.expired() == true);
+}
+
+TEST_CASE("CsIntrusiveWeakPointer batch", "[cs_intrusive_weakpointer]")
+{
+   using RelaxedPolicy = CsPointer::CsIntrusiveRelaxedPolicy;
+
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Parent, RelaxedPolicy> ptr = CsPointer::make_intrusive<Parent, RelaxedPolicy>("batch");
+   std::vector<CsPointer::CsIntrusivePointer<Parent, RelaxedPolicy>> list1(4, ptr);
+
+   // base class has no n-overload, counts are changed one at a time
+   std::vector<CsPointer::CsIntrusivePointer<Parent, RelaxedPolicy>> list2 = CsPointer::copy_intrusive(list1);
+
+   REQUIRE(ptr.use_count() == 9);
+
+   CsPointer::release_intrusive(list1);
+   CsPointer::release_intrusive(list2);
+
+   REQUIRE(ptr.use_count() == 1);
+
+   ptr.reset();
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveWeakPointer try_take_unique", "[cs_intrusive_weakpointer]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Parent> ptr = CsPointer::make_intrusive<Parent>("unique");
+   CsPointer::CsIntrusiveWeakPointer<Parent> weak = ptr;
+
+   Parent *rawPtr = ptr.try_take_unique();
+
+   REQUIRE(rawPtr != nullptr);
+   REQUIRE(weak.expired() == true);
+   REQUIRE(weak.lock() == nullptr);
+
+   delete rawPtr;
+
+   REQUIRE(s_destroyCount == 1);
+}
+
+TEST_CASE("CsIntrusiveWeakPointer threads", "[cs_intrusive_weakpointer]")
+{
+   s_destroyCount = 0;
+
+   CsPointer::CsIntrusivePointer<Parent> ptr = CsPointer::make_intrusive<Parent>("shared");
+   CsPointer::CsIntrusiveWeakPointer<Parent> weak = ptr;
+
+   std::atomic<int> badTag = 0;
+   std::vector<std::thread> threads;
+
+   for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([weak, &badTag] () {
+         for (int j = 0; j < 1000; ++j) {
+            CsPointer::CsIntrusivePointer<Parent> tmp = weak.lock();
+
+            if (tmp != nullptr && tmp->getTag() != "shared") {
+               ++badTag;
+            }
+         }
+      });
+   }
+
+   ptr.reset();
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   REQUIRE(badTag == 0);
+   REQUIRE(s_destroyCount == 1);
+   REQUIRE(weak.expired() == true);
+}
+
+TEST_CASE("CsIntrusiveWeakPointer release_race", "[cs_intrusive_weakpointer]")
+{
+   s_destroyCount = 0;
+
+   for (int i = 0; i < 200; ++i) {
+      CsPointer::CsIntrusivePointer<Parent> ptr = CsPointer::make_intrusive<Parent>("shared");
+      CsPointer::CsIntrusiveWeakPointer<Parent> weak = ptr;
+
+      // the destructor waits for a concurrent lock() to leave the object
+      std::thread thread([weak] () {
+         while (weak.lock() != nullptr) {
+         }
+      });
+
+      ptr.reset();
+      thread.join();
+
+      REQUIRE(weak.expired() == true);
+      REQUIRE(weak.use_count() == 0);
+   }
+
+   REQUIRE(s_destroyCount == 200);
+}
@@ -333,3 +333,119 @@ TEST_CASE("CsNodeManager node-noninheriting", "[cs_nodemanager]")
 
    printf("End of scope, destroy objects\n");
 }
+
+TEST_CASE("CsNodeManager copy", "[cs_nodemanager]")
+{
+   CsPointer::CsNodeManager<Simple> node1;
+
+   IntrusivePtr<Simple> ptrA = CsPointer::make_intrusive<Simple>("obj_A3");
+   IntrusivePtr<Simple> ptrB = CsPointer::make_intrusive<Simple>("obj_B3");
+
+   node1.add_child(ptrA);
+   node1.add_child(ptrB);
+   node1.add_child(ptrA);
+   node1.add_child(ptrA);
+
+   REQUIRE(ptrA.use_count() == 4);
+
+   {
+      CsPointer::CsNodeManager<Simple> node2 = node1;
+
+      REQUIRE(node2.children() == node1.children());
+      REQUIRE(ptrA.use_count() == 7);
+      REQUIRE(ptrB.use_count() == 3);
+
+      node2 = node1;
+
+      REQUIRE(ptrA.use_count() == 7);
+      REQUIRE(ptrB.use_count() == 3);
+   }
+
+   REQUIRE(ptrA.use_count() == 4);
+   REQUIRE(ptrB.use_count() == 2);
+}
+
+class Leaf : public CsPointer::CsNodeManager<Leaf, CsPointer::CsIntrusiveSingleThreadPolicy>,
+      public CsPointer::CsIntrusiveBase_ST
+{
+ public:
+   Leaf(std::string str)
+      : m_tag(str)
+   {
+   }
+
+   std::string getTag() {
+      return m_tag;
+   }
+
+ private:
+   std::string m_tag;
+};
+
+TEST_CASE("CsNodeManager single_thread", "[cs_nodemanager]")
+{
+   using LeafPtr = CsPointer::CsIntrusivePointer<Leaf, CsPointer::CsIntrusiveSingleThreadPolicy>;
+
+   LeafPtr root = CsPointer::make_intrusive<Leaf, CsPointer::CsIntrusiveSingleThreadPolicy>("root");
+   LeafPtr ptrA = CsPointer::make_intrusive<Leaf, CsPointer::CsIntrusiveSingleThreadPolicy>("obj_A");
+   LeafPtr ptrB = CsPointer::make_intrusive<Leaf, CsPointer::CsIntrusiveSingleThreadPolicy>("obj_B");
+
+   root->add_child(ptrA);
+   ptrA->add_child(ptrB);
+
+   REQUIRE(ptrA.use_count() == 2);
+   REQUIRE(ptrB.use_count() == 2);
+
+   LeafPtr ptr = root->find_child<Leaf>( [] (auto item)
+      { return (item->getTag() == "obj_B"); } );
+
+   REQUIRE(ptr == ptrB);
+   REQUIRE(ptrB.use_count() == 3);
+
+   root->clear();
+
+   REQUIRE(ptrA.use_count() == 1);
+   REQUIRE(ptrB.use_count() == 3);
+}
+
+class Panel : public CsPointer::CsNodeManager<Panel>, public CsPointer::CsIntrusiveBase
+{
+ public:
+   Panel(std::string str)
+      : m_tag(str)
+   {
+   }
+
+   ~Panel()
+   {
+      s_log.push_back(m_tag + ":" + std::to_string(children().size()));
+   }
+
+   static inline std::vector<std::string> s_log;
+
+ private:
+   std::string m_tag;
+};
+
+TEST_CASE("CsNodeManager destructor_children", "[cs_nodemanager]")
+{
+   Panel::s_log.clear();
+
+   IntrusivePtr<Panel> root  = CsPointer::make_intrusive<Panel>("root");
+   IntrusivePtr<Panel> ptrA  = CsPointer::make_intrusive<Panel>("obj_A");
+   IntrusivePtr<Panel> ptrB  = CsPointer::make_intrusive<Panel>("obj_B");
+
+   root->add_child(ptrA);
+   root->add_child(ptrB);
+   ptrA->add_child(CsPointer::make_intrusive<Panel>("obj_C"));
+   ptrA->add_child(CsPointer::make_intrusive<Panel>("obj_D"));
+
+   ptrA.reset();
+   ptrB.reset();
+   root.reset();
+
+   // each destructor still sees its children, destruction order is pre-order
+   std::vector<std::string> expected = {"root:2", "obj_A:2", "obj_C:0", "obj_D:0", "obj_B:0"};
+
+   REQUIRE(Panel::s_log == expected);
+}
@@ -0,0 +1,203 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+#include <cs_object_registry.h>
+
+#include <cs_catch2.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class Tracked : public CsPointer::CsIntrusiveBase, public CsPointer::CsTrackedObject<Tracked>
+{
+ public:
+   Tracked(int value)
+      : m_value(value)
+   {
+   }
+
+   int m_value;
+};
+
+struct Untracked {
+   Untracked(int value)
+      : m_value(value)
+   {
+   }
+
+   int m_value;
+};
+
+namespace {
+
+std::size_t live_count(const CsPointer::CsObjectRegistry::Snapshot &snapshot, const char *typeName)
+{
+   auto list = snapshot.count_by_type();
+   auto iter = list.find(typeName);
+
+   return iter == list.end() ? 0 : iter->second;
+}
+
+}
+
+TEST_CASE("CsObjectRegistry disabled", "[cs_object_registry]")
+{
+   CsPointer::CsObjectRegistry::set_enabled(false);
+
+   CsPointer::CsObjectRegistry::Snapshot before = CsPointer::CsObjectRegistry::snapshot();
+
+   CsPointer::CsIntrusivePointer<Tracked> ptr1 = CsPointer::make_intrusive<Tracked>(1);
+   CsPointer::CsSharedPointer<Untracked> ptr2    = CsPointer::make_tracked_shared<Untracked>(2);
+
+   REQUIRE(CsPointer::CsObjectRegistry::snapshot().diff(before).count() == 0);
+}
+
+TEST_CASE("CsObjectRegistry intrusive", "[cs_object_registry]")
+{
+   CsPointer::CsObjectRegistry::set_enabled(true);
+
+   CsPointer::CsObjectRegistry::Snapshot before = CsPointer::CsObjectRegistry::snapshot();
+
+   CsPointer::CsIntrusivePointer<Tracked> ptr1 = CsPointer::make_intrusive<Tracked>(1);
+   CsPointer::CsIntrusivePointer<Tracked> ptr2 = CsPointer::make_intrusive<Tracked>(2);
+   CsPointer::CsIntrusivePointer<Tracked> ptr3 = ptr1;
+
+   CsPointer::CsObjectRegistry::Snapshot after = CsPointer::CsObjectRegistry::snapshot();
+   CsPointer::CsObjectRegistry::Snapshot delta = after.diff(before);
+
+   REQUIRE(delta.count() == 2);
+   REQUIRE(live_count(delta, CsPointer::cs_type_name<Tracked>::name()) == 2);
+   REQUIRE(delta.entries()[0].m_sequence < delta.entries()[1].m_sequence);
+
+   ptr1.reset();
+   ptr3.reset();
+
+   delta = CsPointer::CsObjectRegistry::snapshot().diff(before);
+
+   REQUIRE(delta.count() == 1);
+
+   ptr2.reset();
+
+   REQUIRE(CsPointer::CsObjectRegistry::snapshot().diff(before).count() == 0);
+
+   CsPointer::CsObjectRegistry::set_enabled(false);
+}
+
+TEST_CASE("CsObjectRegistry shared", "[cs_object_registry]")
+{
+   CsPointer::CsObjectRegistry::set_enabled(true);
+
+   CsPointer::CsObjectRegistry::Snapshot before = CsPointer::CsObjectRegistry::snapshot();
+
+   {
+      CsPointer::CsSharedPointer<Untracked> ptr1 = CsPointer::make_tracked_shared<Untracked>(1);
+      CsPointer::CsSharedPointer<Untracked> ptr2 = ptr1;
+
+      CsPointer::CsObjectRegistry::Snapshot delta = CsPointer::CsObjectRegistry::snapshot().diff(before);
+
+      REQUIRE(ptr2->m_value == 1);
+      REQUIRE(delta.count() == 1);
+      REQUIRE(delta.entries()[0].m_ptr == ptr1.get());
+      REQUIRE(live_count(delta, CsPointer::cs_type_name<Untracked>::name()) == 1);
+   }
+
+   REQUIRE(CsPointer::CsObjectRegistry::snapshot().diff(before).count() == 0);
+
+   CsPointer::CsObjectRegistry::set_enabled(false);
+}
+
+struct Named {
+};
+
+template <>
+struct CsPointer::cs_type_name<Named> {
+   static const char *name() {
+      return "Named";
+   }
+};
+
+TEST_CASE("CsObjectRegistry type_name", "[cs_object_registry]")
+{
+   CsPointer::CsObjectRegistry::set_enabled(true);
+
+   CsPointer::CsObjectRegistry::Snapshot before = CsPointer::CsObjectRegistry::snapshot();
+
+   {
+      CsPointer::CsSharedPointer<Named> ptr = CsPointer::make_tracked_shared<Named>();
+
+      REQUIRE(live_count(CsPointer::CsObjectRegistry::snapshot().diff(before), "Named") == 1);
+   }
+
+   CsPointer::CsObjectRegistry::set_enabled(false);
+}
+
+TEST_CASE("CsObjectRegistry backtrace", "[cs_object_registry]")
+{
+   CsPointer::CsObjectRegistry::set_enabled(true);
+   CsPointer::CsObjectRegistry::set_backtrace_sampling(1);
+
+   CsPointer::CsObjectRegistry::Snapshot before = CsPointer::CsObjectRegistry::snapshot();
+
+   CsPointer::CsIntrusivePointer<Tracked> ptr = CsPointer::make_intrusive<Tracked>(1);
+
+   CsPointer::CsObjectRegistry::set_backtrace_sampling(0);
+
+   CsPointer::CsObjectRegistry::Snapshot delta = CsPointer::CsObjectRegistry::snapshot().diff(before);
+
+   REQUIRE(delta.count() == 1);
+   REQUIRE(delta.entries()[0].m_backtrace.empty() == ! CsPointer::CsObjectRegistry::has_backtrace());
+   REQUIRE(delta.to_text().find(CsPointer::cs_type_name<Tracked>::name()) != std::string::npos);
+
+   CsPointer::CsObjectRegistry::set_enabled(false);
+}
+
+TEST_CASE("CsObjectRegistry threads", "[cs_object_registry]")
+{
+   CsPointer::CsObjectRegistry::set_enabled(true);
+
+   CsPointer::CsObjectRegistry::Snapshot before = CsPointer::CsObjectRegistry::snapshot();
+
+   std::vector<CsPointer::CsIntrusivePointer<Tracked>> leaked(4);
+   std::vector<std::thread> threads;
+
+   for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&leaked, i] () {
+         for (int j = 0; j < 1000; ++j) {
+            CsPointer::CsIntrusivePointer<Tracked> tmp = CsPointer::make_intrusive<Tracked>(j);
+         }
+
+         leaked[i] = CsPointer::make_intrusive<Tracked>(i);
+      });
+   }
+
+   for (auto &item : threads) {
+      item.join();
+   }
+
+   CsPointer::CsObjectRegistry::Snapshot delta = CsPointer::CsObjectRegistry::snapshot().diff(before);
+
+   REQUIRE(delta.count() == 4);
+
+   leaked.clear();
+
+   REQUIRE(CsPointer::CsObjectRegistry::snapshot().diff(before).count() == 0);
+
+   CsPointer::CsObjectRegistry::set_enabled(false);
+}
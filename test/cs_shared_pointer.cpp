@@ -125,6 +125,44 @@ TEST_CASE("CsSharedPointer cast", "[cs_sharedpointer]")
    }
 }
 
+TEST_CASE("CsSharedPointer cast_count", "[cs_sharedpointer]")
+{
+   class Fruit
+   {
+    public:
+      virtual ~Fruit() = default;
+   };
+
+   class Apple : public Fruit
+   {
+   };
+
+   CsPointer::CsSharedPointer<Apple> ptr1 = CsPointer::make_shared<Apple>();
+
+   {
+      CsPointer::CsSharedPointer<Fruit> ptr2 = CsPointer::static_pointer_cast<Fruit>(ptr1);
+
+      REQUIRE(ptr2 == ptr1);
+      REQUIRE(ptr1.use_count() == 2);
+
+      CsPointer::CsSharedPointer<Apple> ptr3 = CsPointer::dynamic_pointer_cast<Apple>(std::move(ptr2));
+
+      REQUIRE(ptr2 == nullptr);
+      REQUIRE(ptr3 == ptr1);
+      REQUIRE(ptr1.use_count() == 2);
+   }
+
+   REQUIRE(ptr1.use_count() == 1);
+
+   // failed cast leaves the source unchanged
+   CsPointer::CsSharedPointer<Fruit> ptr4 = CsPointer::make_shared<Fruit>();
+   CsPointer::CsSharedPointer<Apple> ptr5 = CsPointer::dynamic_pointer_cast<Apple>(std::move(ptr4));
+
+   REQUIRE(ptr5 == nullptr);
+   REQUIRE(ptr4 != nullptr);
+   REQUIRE(ptr4.use_count() == 1);
+}
+
 TEST_CASE("CsSharedPointer convert_a", "[cs_sharedpointer]")
 {
    CsPointer::CsSharedPointer<int> ptr1 = CsPointer::make_shared<int>(42);
@@ -0,0 +1,333 @@
+/***********************************************************************
+*
+* Copyright (c) 2023-2025 Barbara Geller
+* Copyright (c) 2023-2025 Ansel Sermersheim
+*
+* This file is part of CsPointer.
+*
+* CsPointer is free software which is released under the BSD 2-Clause license.
+* For license details refer to the LICENSE provided with this project.
+*
+* CsPointer is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* https://opensource.org/licenses/BSD-2-Clause
+*
+***********************************************************************/
+
+#include <cs_intrusive_pointer.h>
+#include <cs_shared_pointer.h>
+#include <cs_small_vector.h>
+#include <cs_unique_pointer.h>
+#include <cs_weak_pointer.h>
+
+#include <cs_catch2.h>
+
+#include <stdexcept>
+#include <string>
+
+class Pebble : public CsPointer::CsIntrusiveBase
+{
+ public:
+   Pebble(int value)
+      : m_value(value)
+   {
+   }
+
+   int m_value;
+};
+
+TEST_CASE("CsSmallVector traits", "[cs_small_vector]")
+{
+   REQUIRE(CsPointer::cs_is_trivially_relocatable_v<int> == true);
+   REQUIRE(CsPointer::cs_is_trivially_relocatable_v<std::string> == false);
+
+   REQUIRE(CsPointer::cs_is_trivially_relocatable_v<CsPointer::CsIntrusivePointer<Pebble>> == true);
+   REQUIRE(CsPointer::cs_is_trivially_relocatable_v<CsPointer::CsSharedPointer<int>> == true);
+   REQUIRE(CsPointer::cs_is_trivially_relocatable_v<CsPointer::CsUniquePointer<int>> == true);
+   REQUIRE(CsPointer::cs_is_trivially_relocatable_v<CsPointer::CsWeakPointer<int>> == true);
+}
+
+TEST_CASE("CsSmallVector grow", "[cs_small_vector]")
+{
+   CsPointer::CsIntrusivePointer<Pebble> ptr = CsPointer::make_intrusive<Pebble>(5);
+
+   CsPointer::CsSmallVector<CsPointer::CsIntrusivePointer<Pebble>, 4> list;
+
+   REQUIRE(list.is_inline() == true);
+   REQUIRE(list.capacity() == 4);
+
+   for (int i = 0; i < 100; ++i) {
+      list.push_back(ptr);
+   }
+
+   REQUIRE(list.is_inline() == false);
+   REQUIRE(list.size() == 100);
+   REQUIRE(ptr.use_count() == 101);
+
+   // element refers to storage which is reallocated
+   list.emplace_back(list[0]);
+
+   REQUIRE(list.size() == 101);
+   REQUIRE(list.back() == ptr);
+   REQUIRE(ptr.use_count() == 102);
+
+   list.clear();
+
+   REQUIRE(ptr.use_count() == 1);
+}
+
+TEST_CASE("CsSmallVector erase_insert", "[cs_small_vector]")
+{
+   CsPointer::CsSmallVector<CsPointer::CsIntrusivePointer<Pebble>, 2> list;
+
+   for (int i = 0; i < 6; ++i) {
+      list.push_back(CsPointer::make_intrusive<Pebble>(i));
+   }
+
+   CsPointer::CsIntrusivePointer<Pebble> ptr = list[2];
+
+   list.erase(list.begin() + 1, list.begin() + 3);
+
+   REQUIRE(list.size() == 4);
+   REQUIRE(ptr.use_count() == 1);
+   REQUIRE(list[0]->m_value == 0);
+   REQUIRE(list[1]->m_value == 3);
+   REQUIRE(list[3]->m_value == 5);
+
+   list.insert(list.begin() + 1, ptr);
+
+   REQUIRE(list.size() == 5);
+   REQUIRE(list[1] == ptr);
+   REQUIRE(list[2]->m_value == 3);
+   REQUIRE(ptr.use_count() == 2);
+
+   list.move_element(0, 4);
+
+   REQUIRE(list[0] == ptr);
+   REQUIRE(list[4]->m_value == 0);
+
+   list.move_element(4, 1);
+
+   REQUIRE(list[0] == ptr);
+   REQUIRE(list[1]->m_value == 0);
+   REQUIRE(list[4]->m_value == 5);
+}
+
+TEST_CASE("CsSmallVector insert_grow", "[cs_small_vector]")
+{
+   CsPointer::CsSmallVector<int, 4> list;
+
+   for (int i = 0; i < 9; ++i) {
+      list.insert(list.begin(), i);
+   }
+
+   // capacity doubles as it does for push_back
+   REQUIRE(list.size() == 9);
+   REQUIRE(list.capacity() == 16);
+   REQUIRE(list[0] == 8);
+   REQUIRE(list[8] == 0);
+}
+
+TEST_CASE("CsSmallVector move", "[cs_small_vector]")
+{
+   CsPointer::CsIntrusivePointer<Pebble> ptr = CsPointer::make_intrusive<Pebble>(7);
+
+   CsPointer::CsSmallVector<CsPointer::CsIntrusivePointer<Pebble>, 4> list1 = {ptr, ptr};
+   CsPointer::CsSmallVector<CsPointer::CsIntrusivePointer<Pebble>, 4> list2 = std::move(list1);
+
+   REQUIRE(list1.empty() == true);
+   REQUIRE(list2.size() == 2);
+   REQUIRE(list2.is_inline() == true);
+   REQUIRE(ptr.use_count() == 3);
+
+   for (int i = 0; i < 10; ++i) {
+      list2.push_back(ptr);
+   }
+
+   list1 = std::move(list2);
+
+   REQUIRE(list2.empty() == true);
+   REQUIRE(list2.is_inline() == true);
+   REQUIRE(list1.size() == 12);
+   REQUIRE(ptr.use_count() == 13);
+
+   list2 = list1;
+
+   REQUIRE(list2.size() == 12);
+   REQUIRE(ptr.use_count() == 25);
+
+   swap(list1, list2);
+   list1.clear();
+
+   REQUIRE(ptr.use_count() == 13);
+}
+
+TEST_CASE("CsSmallVector non_relocatable", "[cs_small_vector]")
+{
+   CsPointer::CsSmallVector<std::string, 2> list;
+
+   for (int i = 0; i < 20; ++i) {
+      list.push_back(std::to_string(i));
+   }
+
+   REQUIRE(list[19] == "19");
+
+   list.erase(list.begin());
+   list.insert(list.begin() + 2, "a string which is too long for small string storage");
+   list.move_element(2, 0);
+
+   REQUIRE(list.size() == 20);
+   REQUIRE(list[0] == "a string which is too long for small string storage");
+   REQUIRE(list[1] == "1");
+   REQUIRE(list[2] == "2");
+
+   CsPointer::CsSmallVector<std::string, 2> copy = list;
+   CsPointer::CsSmallVector<std::string, 2> moved = std::move(list);
+
+   REQUIRE(copy.size() == 20);
+   REQUIRE(moved[19] == "19");
+}
+
+class Flint
+{
+ public:
+   Flint(int value)
+      : m_value(value)
+   {
+      if (value < 0) {
+         throw std::invalid_argument("negative value");
+      }
+   }
+
+   int m_value;
+};
+
+TEST_CASE("CsSmallVector throwing_grow", "[cs_small_vector]")
+{
+   CsPointer::CsSmallVector<Flint, 2> list;
+
+   list.emplace_back(1);
+   list.emplace_back(2);
+
+   REQUIRE_THROWS_AS(list.emplace_back(-1), std::invalid_argument);
+
+   // the vector is unchanged when the new element can not be constructed
+   REQUIRE(list.size() == 2);
+   REQUIRE(list.capacity() == 2);
+   REQUIRE(list.is_inline() == true);
+   REQUIRE(list[1].m_value == 2);
+
+   list.emplace_back(3);
+
+   REQUIRE(list.size() == 3);
+   REQUIRE(list[2].m_value == 3);
+}
+
+namespace {
+
+int s_liveCount  = 0;
+int s_throwAfter = -1;
+
+}
+
+// move and copy may throw, each construction counts down to the failure
+class Quartz
+{
+ public:
+   Quartz(int value)
+      : m_value(value)
+   {
+      ++s_liveCount;
+   }
+
+   Quartz(const Quartz &other)
+      : m_value(other.m_value)
+   {
+      count_down();
+      ++s_liveCount;
+   }
+
+   Quartz(Quartz &&other) noexcept(false)
+      : m_value(other.m_value)
+   {
+      count_down();
+      ++s_liveCount;
+   }
+
+   ~Quartz()
+   {
+      --s_liveCount;
+   }
+
+   int m_value;
+
+ private:
+   static void count_down() {
+      if (s_throwAfter == 0) {
+         throw std::runtime_error("relocation failed");
+      }
+
+      if (s_throwAfter > 0) {
+         --s_throwAfter;
+      }
+   }
+};
+
+TEST_CASE("CsSmallVector throwing_relocate", "[cs_small_vector]")
+{
+   s_liveCount = 0;
+
+   {
+      CsPointer::CsSmallVector<Quartz, 2> list;
+
+      for (int i = 0; i < 4; ++i) {
+         list.emplace_back(i);
+      }
+
+      REQUIRE(list.capacity() == 4);
+
+      // growing fails after two of the four existing elements were relocated
+      s_throwAfter = 2;
+
+      REQUIRE_THROWS_AS(list.emplace_back(4), std::runtime_error);
+      REQUIRE(list.size() == 4);
+      REQUIRE(list.capacity() == 4);
+      REQUIRE(s_liveCount == 4);
+
+      for (int i = 0; i < 4; ++i) {
+         REQUIRE(list[i].m_value == i);
+      }
+
+      s_throwAfter = 1;
+
+      REQUIRE_THROWS_AS(list.reserve(16), std::runtime_error);
+      REQUIRE(list.capacity() == 4);
+      REQUIRE(s_liveCount == 4);
+
+      // moving from inline storage
+      CsPointer::CsSmallVector<Quartz, 2> small;
+      small.emplace_back(7);
+      small.emplace_back(8);
+
+      s_throwAfter = 1;
+
+      using QuartzList = CsPointer::CsSmallVector<Quartz, 2>;
+
+      REQUIRE_THROWS_AS(QuartzList(std::move(small)), std::runtime_error);
+      REQUIRE(small.size() == 2);
+      REQUIRE(small[1].m_value == 8);
+      REQUIRE(s_liveCount == 6);
+
+      s_throwAfter = -1;
+
+      list.emplace_back(4);
+
+      REQUIRE(list.size() == 5);
+      REQUIRE(list[4].m_value == 4);
+      REQUIRE(s_liveCount == 7);
+   }
+
+   REQUIRE(s_liveCount == 0);
+}